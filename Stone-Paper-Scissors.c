@@ -14,424 +14,1205 @@
  * Features ASCII art display for moves, a 'best-of' series format,
  * and robust input handling.
  * Dependencies:
- * - Requires the 'figlet' utility to be installed and accessible in the system's PATH
- * for displaying the final win/loss message.
+ * - The final win/loss message is drawn by a built-in renderer for figlet (.flf)
+ * fonts. The 'figlet' utility is only needed when '--figlet' is passed.
  * - Designed for Unix-like operating systems (Linux, macOS, BSD) due to the use
- * of POSIX-specific functions like fork(), execvp(), usleep(), and sys/wait.h.
+ * of POSIX-specific functions like posix_spawnp(), poll(), and sys/wait.h.
  */
 
 # define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
-# include <stdio.h> // Standard input/output functions (printf, putchar, fgets, scanf)      
-# include <stdlib.h>    // Standard library functions (srand, rand, exit, _exit)    
-# include <string.h>    // String manipulation functions (strlen, strcmp)
-# include <time.h>  // Time functions (time) for seeding random number generator
-# include <unistd.h>    // POSIX operating system API (usleep, fork, execvp, _exit)
-# include <ctype.h> // Character handling functions (tolower)
+# include <stdio.h> // Standard input/output functions (printf, fprintf, snprintf)
+# include <stdlib.h>    // Standard library functions (exit, strtoll, strtoull)
+# include <stdint.h>    // Fixed-width integer types (uint64_t) for the seed
+# include <string.h>    // String manipulation functions (strlen, strcmp, memcmp, strerror)
+# include <errno.h> // Error numbers (EINTR) for the figlet pipe
+# include <time.h>  // Time functions (clock_gettime) for timing '--moves' and '--time-startup'
+# include <unistd.h>    // POSIX operating system API (sysconf, pipe, read, close)
+# include <fcntl.h> // POSIX file control (fcntl) for the figlet pipe
+# include <spawn.h> // POSIX process creation (posix_spawnp) for the external figlet and '--time-startup'
 # include <sys/wait.h>  // POSIX functions for child processes (waitpid, WIFEXITED, WEXITSTATUS)
+# include "sps-art.h" // ASCII art of the moves
+# include "sps-engine.h"    // Round resolution, random numbers and the simulator
+# include "sps-terminal.h"  // Output buffer, animations, player input and round frames
+# include "sps-banner.h"    // Built-in figlet font renderer
+# include "sps-server.h"    // Network game server
+# include "sps-replay.h"    // Scripted games from a move file
+# include "sps-tournament.h"    // Round robins between strategies
+# include "sps-log.h"   // Binary match log
+# include "sps-metrics.h"   // Phase timing for '--stats'
+# include "sps-checkpoint.h"    // Resumable series for '--checkpoint'
 
-// Function prototypes
-/**
- * @brief Prints three ASCII arts side-by-side to the console.
- *
- * This function iterates through each line of the provided ASCII art arrays
- * and prints them sequentially on the same console line, followed by a newline.
- * A short delay is introduced after printing each line to create a retro-like
- * visual effect as the art appears.
- *
- * @param art1 Pointer to the first ASCII art array (array of strings).
- * @param art2 Pointer to the second ASCII art array (array of strings).
- * @param art3 Pointer to the third ASCII art array (array of strings).
- * @param height The number of lines (rows) in each ASCII art.
- * @note Uses usleep for delays, which is POSIX-specific.
- */
-void asciiArtPrinter(const char **art1, const char **art2, const char **art3, int height);
+// Define constants for various configurable aspects of the game
+#define COMBINED_ART_WIDTH "180"    // Maximum width of figlet output to make it consistent with the width of the 3 arts side-by-side.
+#define MAX_ANIMATION_SPEED 1000000 // Upper bound accepted by '--speed'.
+#define SIMULATE_DEFAULT_BEST_OF 3  // 'Best-of' length used by '--simulate' when '--best-of' is not given.
+#define MAX_SIMULATION_THREADS 1024 // Upper bound accepted by '--threads'.
+#define MAX_SERVER_PORT 65535   // Highest TCP port accepted by '--serve'.
+#define VARIANT_PROMPT_MOVES 5  // Variants with more moves list them once before the first round instead of in every prompt.
+#define VARIANT_MOVES_BUFFER 1024   // Buffer for the list of a variant's moves (RPS-101 needs about 900 bytes).
+#define STARTUP_CLOCK_VARIABLE "SPS_STARTUP_CLOCK" // Environment variable handing a '--time-startup' child the clock reading taken before its exec.
 
+// Data types
 /**
- * @brief Generates a random integer within a specified range (inclusive).
- *
- * This function uses the rand() function (seeded by srand in main)
- * to produce a random number within the desired min and max limits.
- *
- * @param min The minimum value for the random number (inclusive).
- * @param max The maximum value for the random number (inclusive).
- * @return A random integer between min and max (inclusive).
+ * @brief Options collected from the command line.
  */
-int randomNumber(int min, int max);
+typedef struct {
+    long long simulateSeries;   // Number of series to simulate headlessly (0 runs the interactive game)
+    int simulateBestOf;         // 'Best-of' length of every simulated series
+    int simulateCompare;        // Non-zero to also time the branchy resolver and report the difference
+    uint64_t seed;              // Seed of the random number generator
+    int seedGiven;              // Non-zero if '--seed' was passed, otherwise the seed is derived from the clock and pid
+    RngKind rngKind;            // Random number generator algorithm
+    int threads;                // Number of simulation threads, or of server event loops
+    long long simulateRounds;   // Number of independent rounds to resolve with the batch kernel
+    const BatchKernel *kernel;  // Batch kernel used by '--rounds', or NULL for the best one this CPU runs
+    double speed;               // Animation speed multiplier (0 disables every delay)
+    const char *fontPath;       // figlet font file for the final banner, or NULL for the built-in font
+    int externalFiglet;         // Non-zero to draw the final banner with the external figlet program
+    unsigned short servePort;   // TCP port of the game server (0 runs the game on the terminal)
+    int serveCompressed;        // Non-zero to offer the server's telnet clients MCCP2 compression ('--compress')
+    unsigned short webPort;     // TCP port of the server's browser client ('--web'), or 0
+    const char *movesPath;      // Move file played by '--moves', or NULL
+    const char *logPath;        // Binary match log appended to by '--log', or NULL
+    StrategySpec computerStrategy;  // Computer's strategy in the game, the replay and the simulator
+    StrategySpec playerStrategy;    // Player's strategy in the simulator
+    const Variant *variant;     // Variant of '--variant', or NULL for the classic game
+    StrategySpec tournament[TOURNAMENT_MAX_STRATEGIES];  // Strategies of '--tournament'
+    int tournamentCount;        // Number of strategies of '--tournament' (0 without it)
+    int stats;                  // Non-zero to time every phase and print the histograms at exit ('--stats')
+    int inPlace;                // Non-zero to redraw the round art in place on a capable terminal ('--in-place')
+    int timeStartup;            // Non-zero to report the time from exec to the first prompt ('--time-startup')
+    const char *checkpointPath; // Checkpoint file of the series in progress ('--checkpoint'), or NULL
+} GameOptions;
 
+// Function prototypes
 /**
  * @brief Prompts the player for their choice (Stone, Paper, or Scissors) and validates it.
  *
  * This function attempts to read valid input for up to MAX_CHOICE_ATTEMPTS times.
- * It converts the input to lowercase for case-insensitive comparison and clears
- * the input buffer after reading. If valid input is received, it returns a
- * corresponding integer. If attempts are exhausted, the program exits.
+ * The buffered input is fed to an incremental choice tokenizer, which matches
+ * the line case-insensitively and discards the rest of an over-long line. If
+ * valid input is received, it returns a corresponding integer. If attempts
+ * are exhausted, the program exits.
  *
+ * @param variant Variant being played, or NULL for the classic game.
  * @return An integer representing the player's choice:
  * 1 for "Stone"
  * 2 for "Paper"
  * 3 for "Scissors"
+ * (or the move, 1 to N, of a variant)
  * @note This function will terminate the program if too many invalid inputs are provided.
  */
-int getPlayerChoice();
+int getPlayerChoice(const Variant *variant);
 
 /**
- * @brief Clears any remaining characters in the standard input buffer up to a newline or EOF.
+ * @brief Prints the final win/loss banner after the queued animation.
+ *
+ * Uses the built-in renderer, or the external figlet program with '--figlet',
+ * which is started before the queued animation plays so that it runs
+ * meanwhile rather than after it.
  *
- * This function is crucial after using scanf or fgets (when fgets doesn't
- * consume all input), to ensure that leftover characters (like newlines) don't
- * interfere with subsequent input operations. It reads and discards characters
- * until a newline character or the end of the input stream (EOF) is encountered.
+ * @param message Message to display.
+ * @param options Pointer to the parsed command line options.
+ * @return 0 on success, 1 on failure.
  */
-void clearInputBuffer();
+int printBanner(const char *message, const GameOptions *options);
 
-// Define constants for various configurable aspects of the game
-#define ART_HEIGHT 20   // Height of each ASCII art in lines.
-#define COMBINED_ART_WIDTH "180"    // Maximum width of figlet output to make it consistent with the width of the 3 arts side-by-side.
-#define MAX_PLAYER_NAME 20  // Maximum characters allowed for the player's name (including null terminator).
-#define MAX_CHOICE_ATTEMPTS 5   // Maximum attempts a player has to enter a valid Stone/Paper/Scissors choice.
-#define MAX_WIN_MESSAGE_BUFFER 120  // Buffer size for the final win/loss message string passed to figlet.
-#define MAX_CHOICE_INPUT_LENGTH 9   // Max characters for player's choice input (e.g., "Scissors" is 7 chars + newline + null).
-// Delays to produce retro-like display effect
-#define UI_MICRO_DELAY_SHORT 100000 // Short delay (100 milliseconds).
-#define UI_MICRO_DELAY_MEDIUM 200000    // Medium delay (200 milliseconds).
-#define UI_MICRO_DELAY_LONG 500000  // Long delay (500 milliseconds).
-
-int main() {
-
-    // Seed the random number generator with the current date and time.
-    // This ensures different random numbers each time the program runs.
-    srand(time(NULL));
-
-    // Define ASCII art for Stone, Paper, Scissors, and the 'VS' separator.
-    // These are arrays of strings, where each string represents a line of the art.
-
-const char *stone[] = {
-        "                                                            ",
-        "                                                            ",
-        "                                                            ",
-        "                        ...'..                              ",
-        "                ...,;cloooolodddl:,..                       ",
-        "          .::clllooooooooooollllllooddddl:,'.               ",
-        "         :lllllllooooooooddoolllllllllldxxxxxxl'            ",
-        "        ,;::cllllooooooooddddddlllllllllldxxxxxxd:          ",
-        "       .,,,,,,,:clodoooooddddddddollllllllxxxxxxxxxc.       ",
-        "        ,,,,,,,,,,,,;::clddddddddddddooolloxxxxxxxxx:       ",
-        "        .,,,,,,,,,,,,,,,,,:clodddddddxxxxdoodxxxxxx:        ",
-        "        ,;;;,,,,,,,,,,,,,,,,,,,;:ccdxxxxxxxxxddlol.         ",
-        "       .;;;;;;;;;;;,,,,,,,,,,,;;;,,::::::;,,'''             ",
-        "       .;;;;;;;;;;;;;;:;;;,,,,''''''''''''''                ",
-        "           ';;;;;;;,,,'''''''''''''''''''.                  ",
-        "                         .''''''''''''.                     ",
-        "                                                            ",
-        "                                                            ",
-        "                                                            ",
-        "                                                            "};
-        
-    const char *paper[] = {
-        "                                                            ",
-        "           ...........................                      ",
-        "           'okkkkkkkkkkk         ;l,  '.                    ",
-        "           'd000000000          .ll;.   ...                 ",
-        "           'd0000000o            ll''      '.               ",
-        "           'd000000k             ;l''......''''             ",
-        "           'd000000.                 lllc    ..             ",
-        "           'd000000                          '.             ",
-        "           'd000000                                         ",
-        "           'd000000                          .              ",
-        "           'd000000'                                        ",
-        "           'd000000O                                        ",
-        "           'd0000000k                        '.             ",
-        "           'd00000000k.                      '.             ",
-        "           'd0000000000l                     '.             ",
-        "           'd000000000000o,                  '.             ",
-        "           'd00000000000000Oc.               '.             ",
-        "           'd00000000000000000x;             '.             ",
-        "           ;;:::::::::::::::::::;'..........''.             ",
-        "                                                            "};
-
-    const char *scissors[] = {
-        "                                                            ",
-        "             .,c:.                        ,x:'.             ",
-        "            .:odOkc.                    ;kxcxKc.            ",
-        "            .codOkldl.               .;kxcxKKKl             ",
-        "              :oxkkl:ol'           .:kxcxKKKO,              ",
-        "                .oxkklcxo'       .:Ox:xKKKO,                ",
-        "                  :oxkkoxko,.  .:OxcxKKKO,                  ",
-        "                    'odkOOOOd,'OxcxKKKO'                    ",
-        "                      'ldkOOOOd;;0KKk.                      ",
-        "                        .ldx:::cd:l'                        ",
-        "                       .'c;c;;:ckOd'.                       ",
-        "                    .':ooc:',cddl:cooc'.                    ",
-        "               ..,:loddddddo;  ,coddddddl:,'..              ",
-        "           .,colc. cldddddc      ;codddl'  'lol;.           ",
-        "          'ld;        'od:.      .,cc,        'oo'          ",
-        "         .cd;          ,dl.      .:c,          ,dl.         ",
-        "          ;dl.        .cdc        ,c:.        .cd;          ",
-        "           .loc,....':oo,          .:c:,....,col.           ",
-        "               .cllc.                   ;cc:                ",
-        "                                                            "};
-
-    const char *vs[] = {
-        "                                                            ",
-        "                     :dkKXWMMMMWXKkd:                       ",
-        "                .lxOXWMMMMMMMMMMMMMMM,                      ",
-        "             ;xKMMMMMMMMMMMMMMMMMMMM'                       ",
-        "          .dXMMMMMMMMMMMMMMMMMMMMMM' d                      ",
-        "         xWMMMMMMMMMMMMMMMMMMMMMMM. xl                      ",
-        "       ,NMMMMMMMMMMMMMMMMMMMMMMMM. kN .'                    ",
-        "      ;WMMMMMMMMMd    dMMMM0      kMl.O .                   ",
-        "     .WMMMMMMMMMM0    'MMMO      OMM:doo:;                  ",
-        "     kMMMMMMMMMMMW     WMO      OMMMMo,KMMMM;               ",
-        "     WMMMMMMMMMMMM.    OO      kMMMMN                       ",
-        "     KMMMMMMMMMMMMl    '       .dNMMMMNd'                   ",
-        "     ,MMMMMMMMMMMMO                kMMMMM;                  ",
-        "      kMMMMMMMMMMMWOoolO    0MMMM; oMMMMl                   ",
-        "       xMMMMMMMMMMMXN'Xo   .d0XNNO0XKko.                    ",
-        "        .MMMMMMMMMMM0NW                                     ",
-        "          ,MMMMMMMMMMMo                                     ",
-        "             XMMMMMMMN                                      ",
-        "                ;MMMW                                       ",
-        "                                                            "};
+/**
+ * @brief Runs the '--simulate' mode and prints aggregate counts and throughput.
+ *
+ * @param options Pointer to the parsed command line options.
+ * @return 0 on success.
+ */
+int runSimulation(const GameOptions *options);
+
+/**
+ * @brief Runs the '--moves' mode: replays the move file, then prints aggregate counts and throughput.
+ *
+ * @param options Pointer to the parsed command line options.
+ * @return 0 on success, 1 if the move file could not be replayed.
+ */
+int runReplay(const GameOptions *options);
+
+/**
+ * @brief Runs the '--tournament' mode: plays the round robin, then prints every pairing and the ranked ratings.
+ *
+ * @param options Pointer to the parsed command line options.
+ * @return 0 on success, 1 if the thread pool could not be started.
+ */
+int runTournamentMode(const GameOptions *options);
+
+/**
+ * @brief Runs '--time-startup': starts the game again as a child, with the same arguments, and waits for it.
+ *
+ * The monotonic clock is read just before the child is spawned and handed to
+ * it in STARTUP_CLOCK_VARIABLE, so the latency the child reports at its first
+ * prompt covers the exec, the dynamic loader (none with 'make static') and
+ * everything main does before the prompt.
+ *
+ * @param argv Argument vector as received by main().
+ * @return The child's exit status, or 1 if it could not be started.
+ */
+int runTimedStartup(char *argv[]);
+
+/**
+ * @brief Prints to stderr how long ago the clock reading of STARTUP_CLOCK_VARIABLE was taken, once the queued prompt is out.
+ */
+static void reportStartup(uint64_t spawned);
+
+/**
+ * @brief Closes the '--log' match log at exit, so a game cut short is still recorded (as abandoned).
+ */
+static void closeGameLog(void);
+
+/**
+ * @brief Prints the phase histograms of '--stats' to stderr at exit.
+ */
+static void printPhaseStats(void);
+
+/**
+ * @brief Writes the '--checkpoint' file out and closes it at exit; an unfinished series stays in it to be resumed.
+ */
+static void closeGameCheckpoint(void);
+
+// Match log of '--log', or NULL without it.
+static MatchLog *gameLog;
+
+// Checkpoint file of '--checkpoint' (its first record holds the series), and the record updates not yet handed to msync.
+static CheckpointFile gameCheckpoint;
+static CheckpointBatch gameCheckpointBatch = {CHECKPOINT_NONE, CHECKPOINT_NONE, 0, 0};
+
+// Environment handed to the external figlet (not declared by every libc's headers).
+extern char **environ;
+
+/**
+ * @brief Parses the command line into a GameOptions structure.
+ *
+ * @param argc Argument count as received by main().
+ * @param argv Argument vector as received by main().
+ * @param options Pointer to the structure to fill in.
+ * @return 0 on success, 1 if the arguments are invalid, -1 if usage was requested.
+ */
+int parseOptions(int argc, char *argv[], GameOptions *options);
+
+/**
+ * @brief Prints the command line usage to the given stream.
+ *
+ * @param stream Output stream (stdout or stderr).
+ * @param program Name the program was invoked with.
+ */
+void printUsage(FILE *stream, const char *program);
+
+int main(int argc, char *argv[]) {
+
+    GameOptions options;    // Options collected from the command line
+    int parseResult = parseOptions(argc, argv, &options);
+
+    if (parseResult == -1)  // Usage was requested
+        return 0;
+
+    if (parseResult != 0)
+        return 1;
+
+    // Only the child started by '--time-startup' plays; it finds the clock reading of its parent in the environment.
+    const char *spawnedAt = options.timeStartup ? getenv(STARTUP_CLOCK_VARIABLE) : NULL;
+    uint64_t spawned = (spawnedAt != NULL) ? strtoull(spawnedAt, NULL, 10) : 0;
+
+    if (options.timeStartup && (spawnedAt == NULL))
+        return runTimedStartup(argv);
+
+    if (spawnedAt != NULL)
+        unsetenv(STARTUP_CLOCK_VARIABLE);
+
+    // Seed the random number generator with the requested seed, or with the current
+    // time and process id so that games started in the same second still differ.
+    if (!options.seedGiven)
+        options.seed = rngEntropySeed();
+
+    rngSeedDefault(options.rngKind, options.seed);
+
+    // Registered first, so it runs after every other exit handler has played and written its output.
+    if (options.stats) {
+        metricsEnable();
+        atexit(printPhaseStats);}
+
+    if (options.logPath != NULL) {
+        gameLog = malloc(sizeof *gameLog);
+
+        if ((gameLog == NULL) || (matchLogOpen(gameLog, options.logPath) != 0)) {
+            perror("Could not open the match log");
+            return 1;}
+
+        atexit(closeGameLog);}
+
+    // Tournaments are headless too; '--simulate' only sets their length.
+    if (options.tournamentCount > 0)
+        return runTournamentMode(&options);
+
+    // The headless simulator skips every prompt, animation and the figlet banner.
+    if ((options.simulateSeries > 0) || (options.simulateRounds > 0))
+        return runSimulation(&options);
+
+    // Scripted games skip the prompts, the art and the banner as well.
+    if (options.movesPath != NULL)
+        return runReplay(&options);
+
+    // Art of each choice, indexed by (choice - 1).
+    const Art *moveArts[3] = {artFind("stone"), artFind("paper"), artFind("scissors")};
+
+    // Every (player, computer) frame is assembled once: by the server before it listens, by the game before its first round.
+    RoundFrame roundFrames[3][3];
+
+    // The server plays every connection with the same frames and resolver; extra event loops get streams of their own.
+    if (options.servePort != 0) {
+        if (buildRoundFrames(moveArts, artFind("vs"), roundFrames) != 0) {
+            perror("Could not build the round frames");
+            return 1;}
+
+        ServerConfig config = {options.servePort, (const RoundFrame (*)[3]) roundFrames, options.fontPath, atoi(COMBINED_ART_WIDTH),
+            options.threads, options.rngKind, options.seed, options.serveCompressed, options.webPort, options.checkpointPath};
+        return serverRun(&config);}
+
+    // Output is scheduled rather than slept on; whatever is still queued is played at exit.
+    atexit(animationDrain);
+    animationSetSpeed(options.speed);
 
     char playerName[MAX_PLAYER_NAME];   // Buffer to store the player's name
     int bestOf; // Variable to store the number of total rounds                        
 
-    usleep(UI_MICRO_DELAY_SHORT);   // Produce short delay 
-    putchar('\n');
-    printf("Player name: ");    // Prompt for player's name
-    usleep(UI_MICRO_DELAY_SHORT);   
-
-    // Read player name, ensuring it doesn't overflow the buffer.
-    fgets(playerName, MAX_PLAYER_NAME, stdin);
-    usleep(UI_MICRO_DELAY_SHORT);    
-
-    size_t len = strlen(playerName);    // Get the length of player input to tackle corner cases
-
-    // Remove the trailing newline character that fgets often captures.
-    // If the input was too long for the buffer, clear the remaining characters.
-    if ((len > 0) && (playerName[len - 1] == '\n')) 
-        playerName[len - 1] = '\0';
-    
-    else
-        clearInputBuffer(); // Clear remaining characters if input was too long
-
-    putchar('\n');  // Print a newline for formatting
-    usleep(UI_MICRO_DELAY_SHORT);             
-    printf("Best of: ");    // Prompt for number of rounds
-    usleep(UI_MICRO_DELAY_SHORT);
-
-    // Collect the input for the bestOf variable.
-    // scanResult checks if scanf successfully read an integer.
-    int scanResult = scanf("%i", &bestOf);      
-    usleep(UI_MICRO_DELAY_SHORT);
-
-    // Clear any remaining characters in the input buffer after scanf.
-    // This prevents issues with subsequent fgets calls.
-    clearInputBuffer();
-
-    // Validate bestOf input: must be a valid integer.
-    if (scanResult != 1) {
-        printf("Invalid input...\n\n");
-        return 1;}  // Exit if input is not an integer
-
-    // Validate bestOf input: must be a positive odd integer.
-    if ((bestOf % 2 == 0) || (bestOf < 0)) {
-        putchar('\n');
-        usleep(UI_MICRO_DELAY_SHORT);
-        printf("Only positive odd integers are valid...\n\n");
-        return 1;}  // Exit if invalid
+    // The series: scores, the computer's random stream and strategy. With '--checkpoint' it lives in the mapped file.
+    static SeriesState gameSeries;
+    SeriesState *series = &gameSeries;
+    CheckpointRecord *record = NULL;
+
+    if (options.checkpointPath != NULL) {
+        if (checkpointOpen(&gameCheckpoint, options.checkpointPath, 1) != 0) {
+            perror("Could not open the checkpoint file");
+            return 1;}
+
+        atexit(closeGameCheckpoint);
+        record = checkpointRecord(&gameCheckpoint, 0);
+        series = &record->series;}
+
+    // A series left unfinished is picked up where it stopped, after checking it against its replay.
+    if ((record != NULL) && record->live) {
+        seriesVerify(series);
+        memcpy(playerName, series->playerName, MAX_PLAYER_NAME);
+        bestOf = series->bestOf;
+
+        animationWrite("\n", 1);
+        animationPrintf("Resuming %s's best of %i at %i : %i...", playerName, bestOf, series->playerWins, series->computerWins);
+        animationWrite("\n", 1);
+
+        if (spawned != 0)
+            reportStartup(spawned);}
+
+    else {
+        // Nothing precedes the first prompt, so there is nothing to pause after.
+        animationWrite("\n", 1);
+        animationPrintf("Player name: ");    // Prompt for player's name
 
-    // Calculate 'n', the number of wins required to win the game.
-    // Example: Best of 3 -> n = (3+1)/2 = 2 wins required.
-    int n = (bestOf + 1) / 2;
+        if (spawned != 0)
+            reportStartup(spawned);
 
-    int playerWins = 0; // Counter for player's wins
-    int computerWins = 0;   // Counter for computer's wins
+        animationDelay(UI_MICRO_DELAY_SHORT);   
+
+        // Read player name, ensuring it doesn't overflow the buffer.
+        inputReadLine(playerName, MAX_PLAYER_NAME);
+        animationDelay(UI_MICRO_DELAY_SHORT);    
+
+        size_t len = strlen(playerName);    // Get the length of player input to tackle corner cases
+
+        // Remove the trailing newline character that inputReadLine often captures.
+        // If the input was too long for the buffer, clear the remaining characters.
+        if ((len > 0) && (playerName[len - 1] == '\n')) 
+            playerName[len - 1] = '\0';
+        
+        else
+            clearInputBuffer(); // Clear remaining characters if input was too long
+
+        animationWrite("\n", 1);  // Print a newline for formatting
+        animationDelay(UI_MICRO_DELAY_SHORT);             
+        animationPrintf("Best of: ");    // Prompt for number of rounds
+        animationDelay(UI_MICRO_DELAY_SHORT);
+
+        // Collect the input for the bestOf variable.
+        // scanResult checks if an integer was read; the rest of the line is discarded.
+        int scanResult = inputReadInteger(&bestOf);      
+        animationDelay(UI_MICRO_DELAY_SHORT);
+
+        // Validate bestOf input: must be a valid integer.
+        if (scanResult != 1) {
+            animationPrintf("Invalid input...\n\n");
+            return 1;}  // Exit if input is not an integer
+
+        // Validate bestOf input: must be a positive odd integer.
+        if ((bestOf % 2 == 0) || (bestOf < 0)) {
+            animationWrite("\n", 1);
+            animationDelay(UI_MICRO_DELAY_SHORT);
+            animationPrintf("Only positive odd integers are valid...\n\n");
+            return 1;}  // Exit if invalid
+
+        // Start the series on the stream main() seeded, so a game plays the same with or without a checkpoint.
+        // It also calculates 'n', the number of wins required to win the game.
+        // Example: Best of 3 -> n = (3+1)/2 = 2 wins required.
+        seriesBegin(series, options.rngKind, options.seed, &options.computerStrategy, playerName, bestOf);
+
+        if (record != NULL) {
+            record->live = 1;
+            checkpointTouch(&gameCheckpointBatch, 0);
+            checkpointSync(&gameCheckpoint, &gameCheckpointBatch);}}
+
+    if (gameLog != NULL)
+        matchLogBegin(gameLog, series->seed, bestOf, playerName);
 
     int playerChoice;   // Stores player's choice (1:Stone, 2:Paper, 3:Scissor)
     int computerChoice; // Stores computer's choice
 
+    // Variants with many moves list them once here rather than in every prompt.
+    if ((options.variant != NULL) && (options.variant->moves > VARIANT_PROMPT_MOVES)) {
+        char moves[VARIANT_MOVES_BUFFER];
+
+        variantFormatMoves(options.variant, moves, sizeof moves);
+        animationWrite("\n", 1);
+        animationPrintf("Moves: ");
+        animationWrite(moves, strlen(moves));
+        animationWrite("\n", 1);
+        animationDelay(UI_MICRO_DELAY_SHORT);}
+
+    // Variants print no art; elsewhere the frames keep scrolling unless stdout is a capable terminal.
+    if (options.variant == NULL) {
+        if (buildRoundFrames(moveArts, artFind("vs"), roundFrames) != 0) {
+            perror("Could not build the round frames");
+            return 1;}
+
+        if (options.inPlace && framesInPlaceEnable((const RoundFrame (*)[3]) roundFrames))
+            atexit(framesInPlaceDisable);}
+
     // Main game loop: continues as long as neither player nor computer has reached 'n' wins.
-    while ((playerWins < n) && (computerWins < n)) {
-
-        playerChoice = getPlayerChoice();   // Get player's choice
-        computerChoice = randomNumber(1, 3);    // Generate computer's random choice (1-3)
-
-        // Game logic to determine the winner of the round based on choices
-        if (playerChoice == 1) {    // Player chose Stone
-            
-            if (computerChoice == 1) {  // Stone vs Stone = Tie
-                asciiArtPrinter(stone, vs, stone, ART_HEIGHT);}
-            
-            else if (computerChoice == 2) { // Stone vs Paper = Computer Wins
-                asciiArtPrinter(stone, vs, paper, ART_HEIGHT);
-                computerWins++;}
-
-            else {  // Stone vs Scissors = Player Wins
-                asciiArtPrinter(stone, vs, scissors, ART_HEIGHT);
-                playerWins++;}}
-             
-        else if (playerChoice == 2) {   // Player chose Paper
-            
-            if (computerChoice == 1) {  // Paper vs Stone = Player Wins
-                asciiArtPrinter(paper, vs, stone, ART_HEIGHT);
-                playerWins++;}
-            
-            else if (computerChoice == 2) { // Paper vs Paper = Tie
-                asciiArtPrinter(paper, vs, paper, ART_HEIGHT);}
-
-            else {  // Paper vs Scissors = Computer Wins
-                asciiArtPrinter(paper, vs, scissors, ART_HEIGHT);
-                computerWins++;}}
-        
-        else {  // Player chose Scissors
-            
-            if (computerChoice == 1) {  // Scissors vs Stone = Computer Wins     
-                asciiArtPrinter(scissors, vs, stone, ART_HEIGHT);
-                computerWins++;}
-            
-            else if (computerChoice == 2) { // Scissors vs Paper = Player Wins
-                asciiArtPrinter(scissors, vs, paper, ART_HEIGHT);
-                playerWins++;}
-
-            else {  // Scissors vs Scissors = Tie
-                asciiArtPrinter(scissors, vs, scissors, ART_HEIGHT);}}
+    while (!seriesOver(series)) {
+
+        playerChoice = getPlayerChoice(options.variant);   // Get player's choice
+        int outcome;
+
+        if (options.variant == NULL) {
+            // Generate computer's choice (1-3), random by default, look up the outcome and update the scores.
+            outcome = seriesPlayRound(series, playerChoice, &computerChoice);
+
+            // Draw the matching art triple: the player's art, 'VS' and the computer's art.
+            asciiArtPrinter(&roundFrames[playerChoice - 1][computerChoice - 1]);}
+
+        // Variants have no art: the computer plays at random and the round is a line of text.
+        else {
+            computerChoice = (int) rngBounded(rngDefault(), (uint32_t) options.variant->moves) + 1;
+            outcome = variantResolve(options.variant, playerChoice, computerChoice);
+            animationPrintf("%s  VS  %s\n", options.variant->moveNames[playerChoice - 1], options.variant->moveNames[computerChoice - 1]);
+            animationDelay(UI_MICRO_DELAY_SHORT);
+
+            // Branch-free score update: a tie adds to neither counter.
+            series->playerWins += (outcome == ROUND_PLAYER_WINS);
+            series->computerWins += (outcome == ROUND_COMPUTER_WINS);}
+
+        if (gameLog != NULL)
+            matchLogRound(gameLog, playerChoice, computerChoice, outcome);
+
+        // The round is already in the mapped record; a finished series is not resumed.
+        if (record != NULL) {
+            record->live = !seriesOver(series);
+            checkpointTouch(&gameCheckpointBatch, 0);
+            checkpointSync(&gameCheckpoint, &gameCheckpointBatch);}
 
         // After each round, check if the game has concluded or continues.
-        if ((playerWins != n) && (computerWins != n)) { 
-            putchar('\n');
-            usleep(UI_MICRO_DELAY_SHORT);
-            printf("%s : %i | Computer : %i", playerName, playerWins, computerWins);    // If the game is still ongoing, display current scores.
-            usleep(UI_MICRO_DELAY_SHORT);
-            putchar('\n');
-            usleep(UI_MICRO_DELAY_SHORT);}
+        if (!seriesOver(series)) { 
+            animationWrite("\n", 1);
+            animationDelay(UI_MICRO_DELAY_SHORT);
+            animationPrintf("%s : %i | Computer : %i", playerName, series->playerWins, series->computerWins);    // If the game is still ongoing, display current scores.
+            animationDelay(UI_MICRO_DELAY_SHORT);
+            animationWrite("\n", 1);
+            animationDelay(UI_MICRO_DELAY_SHORT);}
 
         // Game has concluded (either player or computer won the game).
         else {  
 
             char winMessage[MAX_WIN_MESSAGE_BUFFER];    // Buffer for the final win/loss message
 
-            // Arguments for the figlet command: executable, width flag, width value, message, NULL terminator.
-            char *figlet[5] = {"figlet", "-w", COMBINED_ART_WIDTH, winMessage, NULL};
-
             // Add pauses to simulate processing of scores before revealing the final result.
-            putchar('\n');
-            usleep(UI_MICRO_DELAY_MEDIUM);
-            printf(".\n");
-            usleep(UI_MICRO_DELAY_LONG);
-            printf("..\n");
-            usleep(UI_MICRO_DELAY_LONG);
-            printf("...\n");
-            usleep(UI_MICRO_DELAY_LONG);
-            putchar('\n');
-            usleep(UI_MICRO_DELAY_MEDIUM);
+            animationWrite("\n", 1);
+            animationDelay(UI_MICRO_DELAY_MEDIUM);
+            animationPrintf(".\n");
+            animationDelay(UI_MICRO_DELAY_LONG);
+            animationPrintf("..\n");
+            animationDelay(UI_MICRO_DELAY_LONG);
+            animationPrintf("...\n");
+            animationDelay(UI_MICRO_DELAY_LONG);
+            animationWrite("\n", 1);
+            animationDelay(UI_MICRO_DELAY_MEDIUM);
+
+            if (gameLog != NULL)
+                matchLogEnd(gameLog, 1);
 
             // Format the final win message based on who won the game.
-            if (playerWins == n) 
-                snprintf(winMessage, MAX_WIN_MESSAGE_BUFFER, "%s  :  %i        |        Computer  :  %i\n%s   wins !", playerName, playerWins, computerWins, playerName);
-            else
-                snprintf(winMessage, MAX_WIN_MESSAGE_BUFFER, "%s  :  %i        |        Computer  :  %i\nComputer   wins !", playerName, playerWins, computerWins);
-
-            // Fork a new process to execute the 'figlet' command.
-            pid_t pid = fork();
-
-            if (pid == -1) {
-                // Handle fork failure.
-                perror("Fork failed");
-                return 1;} 
-            
-            else if (pid == 0) {
-                // This is the child process. It will execute figlet.
-                // execvp replaces the current process image with a new one (figlet).
-                execvp(figlet[0], figlet);
-                // If execvp returns, it means it failed to execute figlet.
-                perror("Figlet execution failed");
-                // Use _exit to terminate the child process immediately without flushing buffers
-                // that might belong to the parent process or calling atexit handlers.
-                _exit(1);}
-            
-            else {
-                // This is the parent process.
-                int status;
-                waitpid(pid, &status, 0);   // Wait for child to exit
-
-                // Check how the child process terminated.
-                if (WIFEXITED(status) != 0) {
-                    // Child terminated normally. Check its exit status.
-                    if (WEXITSTATUS(status) != 0) {
-                        // Child exited with a non-zero status, indicating an error in figlet.
-                        fprintf(stderr, "Child process failed to execute with status %d\n", WEXITSTATUS(status));
-                        return 1;}}
+            formatWinMessage(winMessage, MAX_WIN_MESSAGE_BUFFER, playerName, series->playerWins, series->computerWins);
 
-                else {
-                    // Child process terminated abnormally (e.g., by a signal).
-                    fprintf(stderr, "Child process terminated abnormally\n");
-                    return 1;}}}}
+            // Draw the final message as a banner.
+            if (printBanner(winMessage, &options) != 0)
+                return 1;}}
                 
     return 0;}  // Program completed successfully
 
-void asciiArtPrinter(const char **art1, const char **art2, const char **art3, int height) {
+int getPlayerChoice(const Variant *variant) { 
 
-    for(int i = 0; i < height; i++) {
+    static ChoiceTokenizer tokenizer;   // Zero-initialised: no partial line, no invalid attempts, the classic game
+    char prompt[VARIANT_MOVES_BUFFER] = "Stone, Paper or Scissors";
 
-        printf("%s%s%s\n", *art1, *art2, *art3); // Print line from first, second and third art side-by-side
-        art1++; art2++; art3++; // Move the pointers to the next line in each art
-        usleep(UI_MICRO_DELAY_SHORT);}}
+    // A variant's moves are listed in the prompt, unless there are too many (see main).
+    if (variant != NULL) {
+        tokenizer.variant = (uint8_t) variant->id;
 
-int randomNumber(int min, int max) {
+        if (variant->moves <= VARIANT_PROMPT_MOVES)
+            variantFormatMoves(variant, prompt, sizeof prompt);
+        else
+            strcpy(prompt, "Your move");}
 
-    int number;
+    for (;;) {
 
-    number = rand() % (max - min + 1) + min;
+        animationWrite("\n", 1);
+        animationDelay(UI_MICRO_DELAY_SHORT);
+        animationPrintf("%s: ", prompt);
+        animationDelay(UI_MICRO_DELAY_SHORT);
 
-    return number;}
+        // Hand the tokenizer whatever input is buffered until it has seen a whole line.
+        int choice = CHOICE_PENDING;
 
-int getPlayerChoice() { 
+        while (choice == CHOICE_PENDING) {
+            size_t available;
+            const char *input = inputPeek(&available);
 
-    for(int i = 0; i < MAX_CHOICE_ATTEMPTS; i++) {
-    
-        char tempPlayerChoice[MAX_CHOICE_INPUT_LENGTH]; // Buffer for player's string input
+            if (input == NULL)
+                choice = choiceTokenizerEndLine(&tokenizer);    // End of input ends the line
+            else
+                inputConsume(choiceTokenizerFeed(&tokenizer, input, available, &choice));}
+
+        animationWrite("\n", 1);
+        animationDelay(UI_MICRO_DELAY_SHORT);
+
+        if (choice > 0)
+            return choice;
+
+        // Invalid input, prompt again.
+        animationPrintf("Invalid Choice...\n");
+        animationDelay(UI_MICRO_DELAY_SHORT);
+
+        if (choice == CHOICE_EXHAUSTED)
+            break;}
+
+    // If loop exits, it means max attempts were exceeded.
+    animationPrintf("Too many invalid inputs...\n");
+    exit(1);}   // Terminate program with error status
+
+/**
+ * @brief Starts the external figlet program (the original behaviour) with its output going to a pipe.
+ *
+ * @param output Set to the read end of the pipe.
+ * @return The child's process ID, or -1 if figlet could not be started.
+ */
+static pid_t startExternalFiglet(const char *message, int *output) {
+
+    // Arguments for the figlet command: executable, width flag, width value, message, NULL terminator.
+    char *figlet[5] = {"figlet", "-w", COMBINED_ART_WIDTH, (char *) message, NULL};
+    int pipeEnds[2];
+
+    if (pipe(pipeEnds) != 0) {
+        perror("Pipe creation failed");
+        return -1;}
+
+    // Neither end is inherited as such: the child only gets the write end, as its stdout.
+    fcntl(pipeEnds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(pipeEnds[1], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    pid_t pid;
+    int error = posix_spawn_file_actions_init(&actions);
+
+    if (error == 0) {
+        error = posix_spawn_file_actions_adddup2(&actions, pipeEnds[1], STDOUT_FILENO);
+
+        // posix_spawnp searches PATH like execvp, without copying the parent's address space first.
+        if (error == 0)
+            error = posix_spawnp(&pid, figlet[0], &actions, NULL, figlet, environ);
+
+        posix_spawn_file_actions_destroy(&actions);}
+
+    close(pipeEnds[1]);
+
+    if (error != 0) {
+        fprintf(stderr, "Figlet execution failed: %s\n", strerror(error));
+        close(pipeEnds[0]);
+        return -1;}
+
+    *output = pipeEnds[0];
+
+    return pid;}
+
+/**
+ * @brief Queues everything figlet wrote, then reaps the child started by startExternalFiglet.
+ *
+ * @return 0 on success, 1 if figlet failed.
+ */
+static int finishExternalFiglet(pid_t pid, int output) {
+
+    char chunk[4096];
+    ssize_t received;
+
+    // Read until figlet closes its end of the pipe, i.e. exits.
+    while (((received = read(output, chunk, sizeof chunk)) > 0) || ((received < 0) && (errno == EINTR)))
+        if (received > 0)
+            animationWrite(chunk, (size_t) received);
+
+    close(output);
+
+    int status;
+
+    while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR))
+        ;
+
+    // Check how the child process terminated.
+    if (WIFEXITED(status) != 0) {
+        // Child terminated normally. Check its exit status.
+        if (WEXITSTATUS(status) != 0) {
+            // Child exited with a non-zero status, indicating an error in figlet.
+            fprintf(stderr, "Child process failed to execute with status %d\n", WEXITSTATUS(status));
+            return 1;}}
+
+    else {
+        // Child process terminated abnormally (e.g., by a signal).
+        fprintf(stderr, "Child process terminated abnormally\n");
+        return 1;}
+
+    animationDrain();
+
+    return 0;}
+
+int printBanner(const char *message, const GameOptions *options) {
+
+    // The banner is produced while the closing animation still plays, and queued after it.
+    if (options->externalFiglet) {
+        int output;
+        pid_t pid = startExternalFiglet(message, &output);
+
+        if (pid < 0)
+            return 1;
+
+        animationDrain();
+
+        // The banner phase is only what figlet still needs once the animation is over.
+        uint64_t start = metricsStart();
+        int status = finishExternalFiglet(pid, output);
+
+        metricsStop(METRIC_BANNER, start);
+        return status;}
+
+    // The banner phase runs through loading the font and rendering.
+    uint64_t start = metricsStart();
+    const BannerFont *font = bannerLoadFont(options->fontPath);
+    size_t length;
+    char *banner = (font != NULL) ? bannerRender(font, message, atoi(COMBINED_ART_WIDTH), &length) : NULL;
+
+    metricsStop(METRIC_BANNER, start);
+
+    if (banner == NULL) {
+        fprintf(stderr, "Banner rendering failed\n");
+        return 1;}
+
+    animationWrite(banner, length);
+    animationDrain();
+    free(banner);
+
+    return 0;}
+
+/**
+ * @brief Describes the simulation requested on the command line.
+ */
+static SimulationJob simulationJobFromOptions(const GameOptions *options, int (*resolver)(int, int), const BatchKernel *kernel) {
+
+    SimulationJob job = {
+        .series = options->simulateSeries,
+        .bestOf = options->simulateBestOf,
+        .resolver = resolver,
+        .playerStrategy = options->playerStrategy,
+        .computerStrategy = options->computerStrategy,
+        .variant = options->variant,
+        .rounds = options->simulateRounds,
+        .kernel = kernel,
+        .seed = options->seed,
+        .rngKind = options->rngKind,
+        .threads = options->threads};
+
+    return job;}
+
+/**
+ * @brief Runs '--rounds': resolves independent rounds with the selected batch kernel.
+ */
+static int runBatchSimulation(const GameOptions *options) {
+
+    SimulationResult result = {0};
+    const BatchKernel *kernel = (options->kernel != NULL) ? options->kernel : batchKernelFind(NULL);   // The CPU is only probed when needed
+    SimulationJob job = simulationJobFromOptions(options, NULL, kernel);
+    double elapsed = runSimulationJob(&job, &result);
+
+    if (elapsed < 0)
+        return 1;
+
+    printf("Rounds played     : %lld\n", options->simulateRounds);
+    printf("Kernel            : %s (%i lanes)\n", kernel->name, BATCH_LANES);
+    printf("Seed              : %llu (xoshiro256**)\n", (unsigned long long) options->seed);
+    printf("Threads           : %i\n", options->threads);
+    printf("Player rounds     : %lld\n", result.playerRounds);
+    printf("Computer rounds   : %lld\n", result.computerRounds);
+    printf("Tied rounds       : %lld\n", result.ties);
+    printf("Elapsed seconds   : %.6f\n", elapsed);
+    printf("Rounds per second : %.0f\n", (elapsed > 0) ? (double) options->simulateRounds / elapsed : 0.0);
+
+    if (options->simulateCompare) {
+
+        SimulationResult scalarResult = {0};
+        job.kernel = batchKernelScalarReference();
+        double scalarElapsed = runSimulationJob(&job, &scalarResult);
+
+        if (scalarElapsed < 0)
+            return 1;
 
         putchar('\n');
-        usleep(UI_MICRO_DELAY_SHORT);
-        printf("Stone, Paper or Scissors: ");
-        usleep(UI_MICRO_DELAY_SHORT);
-        fgets(tempPlayerChoice, MAX_CHOICE_INPUT_LENGTH, stdin);
-        putchar('\n');
-        usleep(UI_MICRO_DELAY_SHORT);
+        printf("Scalar kernel     : %.6f seconds, %.0f rounds per second\n", scalarElapsed, (scalarElapsed > 0) ? (double) options->simulateRounds / scalarElapsed : 0.0);
+        printf("Kernel speed-up   : %.2fx\n", (elapsed > 0) ? scalarElapsed / elapsed : 0.0);
 
-        size_t len = strlen(tempPlayerChoice);
+        // Every kernel must reproduce the scalar reference exactly.
+        if (memcmp(&result, &scalarResult, sizeof result) != 0) {
+            fprintf(stderr, "Kernel %s disagrees with the scalar reference...\n", kernel->name);
+            return 1;}}
 
-        // Remove trailing newline or clear buffer if input exceeds buffer size.
-        if ((len > 0) && (tempPlayerChoice[len - 1] == '\n')) 
-            tempPlayerChoice[len - 1] = '\0';
-        
-        else 
-            clearInputBuffer();
-        
-        // Convert the input string to lowercase for case-insensitive comparison.
-        for (size_t i = 0; i < len; i++)    // Use size_t for loop counter 'i' to match 'len' (from strlen) and avoid -Wsign-compare warning.
-            tempPlayerChoice[i] = tolower((unsigned char) tempPlayerChoice[i]);
+    return 0;}
+
+int runSimulation(const GameOptions *options) {
+
+    if (options->simulateRounds > 0)
+        return runBatchSimulation(options);
+
+    SimulationResult result = {0};
+    SimulationJob job = simulationJobFromOptions(options, resolveRound, NULL);
+    double elapsed = runSimulationJob(&job, &result);
+
+    if (elapsed < 0)
+        return 1;
+
+    long long rounds = result.playerRounds + result.computerRounds + result.ties;
+
+    printf("Series played     : %lld (best of %i)\n", options->simulateSeries, options->simulateBestOf);
+    printf("Seed              : %llu (%s)\n", (unsigned long long) options->seed, (options->rngKind == RNG_PCG32) ? "pcg32" : "xoshiro256**");
+    printf("Threads           : %i\n", options->threads);
+
+    if ((options->playerStrategy.kind != STRATEGY_RANDOM) || (options->computerStrategy.kind != STRATEGY_RANDOM)) {
+        char playerName[16], computerName[16];
 
-        // Compare input string to valid choices.
-        if (strcmp(tempPlayerChoice, "stone") == 0)
+        strategyFormat(&options->playerStrategy, playerName, sizeof playerName);
+        strategyFormat(&options->computerStrategy, computerName, sizeof computerName);
+        printf("Strategies        : %s (player) vs %s (computer)\n", playerName, computerName);}
+
+    if (options->variant != NULL)
+        printf("Variant           : %s (%i moves)\n", options->variant->name, options->variant->moves);
+
+    printf("Player series     : %lld\n", result.playerSeries);
+    printf("Computer series   : %lld\n", result.computerSeries);
+
+    if (result.drawnSeries > 0)
+        printf("Drawn series      : %lld (stopped after %i rounds)\n", result.drawnSeries, STRATEGY_MAX_SERIES_ROUNDS);
+
+    printf("Rounds played     : %lld\n", rounds);
+    printf("Player rounds     : %lld\n", result.playerRounds);
+    printf("Computer rounds   : %lld\n", result.computerRounds);
+    printf("Tied rounds       : %lld\n", result.ties);
+    printf("Elapsed seconds   : %.6f\n", elapsed);
+    printf("Rounds per second : %.0f\n", (elapsed > 0) ? (double) rounds / elapsed : 0.0);
+
+    if (options->simulateCompare) {
+
+        SimulationResult branchyResult = {0};
+        job.resolver = resolveRoundBranchy;
+        double branchyElapsed = runSimulationJob(&job, &branchyResult);
+
+        if (branchyElapsed < 0)
             return 1;
 
-        else if (strcmp(tempPlayerChoice, "paper") == 0)
-            return 2;
+        putchar('\n');
+        printf("Branchy resolver  : %.6f seconds, %.0f rounds per second\n", branchyElapsed, (branchyElapsed > 0) ? (double) rounds / branchyElapsed : 0.0);
+        printf("Table speed-up    : %.2fx\n", (elapsed > 0) ? branchyElapsed / elapsed : 0.0);
+
+        // Both resolvers consumed the same random stream, so every counter must match.
+        if (memcmp(&result, &branchyResult, sizeof result) != 0) {
+            fprintf(stderr, "Resolvers disagree on the same seed...\n");
+            return 1;}}
+
+    return 0;}
+
+static void printPhaseStats(void) {
+
+    char table[2048];
+    size_t length = metricsFormat(table, sizeof table);
+
+    fprintf(stderr, "\n%.*s", (int) length, table);}
+
+static void closeGameLog(void) {
+
+    if (matchLogClose(gameLog) != 0)
+        fprintf(stderr, "Could not write the match log...\n");}
+
+static void closeGameCheckpoint(void) {
+
+    checkpointClose(&gameCheckpoint);}
+
+int runTournamentMode(const GameOptions *options) {
+
+    TournamentJob job = {
+        .strategies = options->tournament,
+        .count = options->tournamentCount,
+        .series = (options->simulateSeries > 0) ? options->simulateSeries : TOURNAMENT_DEFAULT_SERIES,
+        .bestOf = options->simulateBestOf,
+        .seed = options->seed,
+        .rngKind = options->rngKind,
+        .threads = options->threads};
+    static TournamentResult result;     // Static: the pairing table is too large to want on the stack
+    double elapsed = runTournament(&job, &result);
+
+    if (elapsed < 0)
+        return 1;
+
+    char names[TOURNAMENT_MAX_STRATEGIES][16];
+    long long series = 0, rounds = 0;
+
+    for (int i = 0; i < job.count; i++)
+        strategyFormat(&job.strategies[i], names[i], sizeof names[i]);
+
+    printf("Strategies        : %i (%i pairings)\n", job.count, result.pairingCount);
+    printf("Series per pairing: %lld (best of %i)\n", job.series, job.bestOf);
+    printf("Seed              : %llu (%s)\n", (unsigned long long) options->seed, (options->rngKind == RNG_PCG32) ? "pcg32" : "xoshiro256**");
+    printf("Threads           : %i (%lld tasks, %lld stolen)\n", job.threads, result.tasks, result.steals);
+
+    printf("\nPairing                      Wins    Losses   Draws  Score\n");
+
+    for (int p = 0; p < result.pairingCount; p++) {
+        const TournamentPairing *pairing = &result.pairings[p];
+        char title[40];
+
+        snprintf(title, sizeof title, "%s vs %s", names[pairing->first], names[pairing->second]);
+        printf("%-24s %9lld %9lld %7lld %6.1f%%\n", title, pairing->firstSeries, pairing->secondSeries, pairing->drawnSeries,
+            100.0 * ((double) pairing->firstSeries + 0.5 * (double) pairing->drawnSeries) / (double) job.series);
+
+        series += job.series;
+        rounds += pairing->firstRounds + pairing->secondRounds + pairing->ties;}
+
+    // Ranked by rating; a strategy's record sums its pairings.
+    int order[TOURNAMENT_MAX_STRATEGIES];
+
+    for (int i = 0; i < job.count; i++) {
+        int position = i;
+
+        for (; (position > 0) && (result.elo[order[position - 1]] < result.elo[i]); position--)
+            order[position] = order[position - 1];
+
+        order[position] = i;}
+
+    printf("\nRank  Strategy       Elo       Wins    Losses   Draws  Score\n");
+
+    for (int rank = 0; rank < job.count; rank++) {
+        int i = order[rank];
+        long long wins = 0, losses = 0, draws = 0;
+
+        for (int p = 0; p < result.pairingCount; p++) {
+            const TournamentPairing *pairing = &result.pairings[p];
+
+            if ((pairing->first != i) && (pairing->second != i))
+                continue;
+
+            wins += (pairing->first == i) ? pairing->firstSeries : pairing->secondSeries;
+            losses += (pairing->first == i) ? pairing->secondSeries : pairing->firstSeries;
+            draws += pairing->drawnSeries;}
+
+        printf("%-5i %-10s %7.0f %10lld %9lld %7lld %6.1f%%\n", rank + 1, names[i], result.elo[i], wins, losses, draws,
+            100.0 * ((double) wins + 0.5 * (double) draws) / (double) (job.series * (job.count - 1)));}
+
+    printf("\nRounds played     : %lld\n", rounds);
+    printf("Elapsed seconds   : %.6f\n", elapsed);
+    printf("Series per second : %.0f\n", (elapsed > 0) ? (double) series / elapsed : 0.0);
+
+    return 0;}
+
+int runReplay(const GameOptions *options) {
+
+    ReplayResult result;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = replayMoves(options->movesPath, options->simulateBestOf, &options->computerStrategy, gameLog, options->seed, &result);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (status != 0)
+        return 1;
+
+    double elapsed = (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("\nMove file         : %s (%s, best of %i)\n", options->movesPath, result.packed ? "packed" : "text", options->simulateBestOf);
+    printf("Seed              : %llu (%s)\n", (unsigned long long) options->seed, (options->rngKind == RNG_PCG32) ? "pcg32" : "xoshiro256**");
+    printf("Moves played      : %lld (%lld invalid lines)\n", result.moves, result.invalidLines);
+    printf("Series completed  : %lld%s\n", result.series, result.unfinished ? " (the last one is unfinished)" : "");
+    printf("Player series     : %lld\n", result.playerSeries);
+    printf("Computer series   : %lld\n", result.computerSeries);
+    printf("Player rounds     : %lld\n", result.playerRounds);
+    printf("Computer rounds   : %lld\n", result.computerRounds);
+    printf("Tied rounds       : %lld\n", result.ties);
+    printf("Elapsed seconds   : %.6f\n", elapsed);
+    printf("Moves per second  : %.0f\n", (elapsed > 0) ? (double) result.moves / elapsed : 0.0);
+
+    return 0;}
+
+/**
+ * @brief Reads the monotonic clock in nanoseconds.
+ */
+static uint64_t monotonicNanoseconds(void) {
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;}
+
+int runTimedStartup(char *argv[]) {
+
+    char reading[24];
+    pid_t pid;
+
+    // The child reads the clock of its parent: CLOCK_MONOTONIC is the same for every process.
+    snprintf(reading, sizeof reading, "%llu", (unsigned long long) monotonicNanoseconds());
+
+    int error = (setenv(STARTUP_CLOCK_VARIABLE, reading, 1) == 0) ? posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ) : errno;
+
+    if (error != 0) {
+        fprintf(stderr, "Could not start the timed game: %s\n", strerror(error));
+        return 1;}
+
+    int status;
+
+    while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR))
+        ;
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 1;}
+
+static void reportStartup(uint64_t spawned) {
+
+    animationDrain();
+    fprintf(stderr, "Startup: %.1f microseconds from exec to the first prompt\n", (double) (monotonicNanoseconds() - spawned) / 1e3);}
+
+int parseOptions(int argc, char *argv[], GameOptions *options) {
+
+    options->simulateSeries = 0;
+    options->simulateBestOf = SIMULATE_DEFAULT_BEST_OF;
+    options->simulateCompare = 0;
+    options->seed = 0;
+    options->seedGiven = 0;
+    options->rngKind = RNG_XOSHIRO256;
+    options->threads = 1;
+    options->simulateRounds = 0;
+    options->kernel = NULL;
+    options->speed = 1.0;
+    options->fontPath = NULL;
+    options->externalFiglet = 0;
+    options->servePort = 0;
+    options->serveCompressed = 0;
+    options->webPort = 0;
+    options->movesPath = NULL;
+    options->logPath = NULL;
+    options->computerStrategy = (StrategySpec) {STRATEGY_RANDOM, STRATEGY_DEFAULT_ORDER};
+    options->playerStrategy = options->computerStrategy;
+    options->variant = NULL;
+    options->tournamentCount = 0;
+    options->stats = 0;
+    options->inPlace = 0;
+    options->timeStartup = 0;
+    options->checkpointPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;   // Argument following the option, if any
+        char *end;
+
+        if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+            printUsage(stdout, argv[0]);
+            return -1;}
+
+        else if (strcmp(argv[i], "--compare") == 0)
+            options->simulateCompare = 1;
+
+        else if ((strcmp(argv[i], "--speed") == 0) && (value != NULL)) {
+            options->speed = strtod(value, &end);
+
+            if ((*end != '\0') || (end == value) || !(options->speed >= 0) || (options->speed > MAX_ANIMATION_SPEED)) {
+                fprintf(stderr, "--speed expects a number between 0 and %i...\n", MAX_ANIMATION_SPEED);
+                return 1;}
+
+            i++;}
+
+        else if (strcmp(argv[i], "--no-delay") == 0)
+            options->speed = 0;
+
+        else if ((strcmp(argv[i], "--font") == 0) && (value != NULL)) {
+            options->fontPath = value;
+            i++;}
+
+        else if (strcmp(argv[i], "--figlet") == 0)
+            options->externalFiglet = 1;
+
+        else if (strcmp(argv[i], "--in-place") == 0)
+            options->inPlace = 1;
+
+        else if (strcmp(argv[i], "--stats") == 0)
+            options->stats = 1;
+
+        else if (strcmp(argv[i], "--time-startup") == 0)
+            options->timeStartup = 1;
+
+        else if ((strcmp(argv[i], "--serve") == 0) && (value != NULL)) {
+            long port = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (end == value) || (port < 1) || (port > MAX_SERVER_PORT)) {
+                fprintf(stderr, "--serve expects a port between 1 and %i...\n", MAX_SERVER_PORT);
+                return 1;}
+
+            options->servePort = (unsigned short) port;
+            i++;}
+
+        else if (strcmp(argv[i], "--compress") == 0)
+            options->serveCompressed = 1;
+
+        else if ((strcmp(argv[i], "--web") == 0) && (value != NULL)) {
+            long port = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (end == value) || (port < 1) || (port > MAX_SERVER_PORT)) {
+                fprintf(stderr, "--web expects a port between 1 and %i...\n", MAX_SERVER_PORT);
+                return 1;}
+
+            options->webPort = (unsigned short) port;
+            i++;}
+
+        else if ((strcmp(argv[i], "--log") == 0) && (value != NULL)) {
+            options->logPath = value;
+            i++;}
+
+        else if ((strcmp(argv[i], "--checkpoint") == 0) && (value != NULL)) {
+            options->checkpointPath = value;
+            i++;}
+
+        else if (((strcmp(argv[i], "--strategy") == 0) || (strcmp(argv[i], "--player-strategy") == 0)) && (value != NULL)) {
+            StrategySpec *spec = (argv[i][2] == 's') ? &options->computerStrategy : &options->playerStrategy;
+
+            if (strategyParse(value, spec) != 0) {
+                fprintf(stderr, "%s expects random, frequency, markov, markov1 to markov%i, ensemble or cycle...\n", argv[i], STRATEGY_MAX_ORDER);
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--tournament") == 0) && (value != NULL)) {
+            char list[256];
+            char *save = NULL;
+
+            // A comma-separated list of distinct strategies, e.g. random,frequency,markov,ensemble.
+            snprintf(list, sizeof list, "%s", value);
+            options->tournamentCount = 0;
+
+            for (char *name = strtok_r(list, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save)) {
+                StrategySpec spec;
+                char formatted[16], other[16];
+
+                if ((options->tournamentCount == TOURNAMENT_MAX_STRATEGIES) || (strategyParse(name, &spec) != 0)) {
+                    fprintf(stderr, "--tournament expects up to %i comma-separated strategies (random, frequency, markov[1-%i], ensemble, cycle)...\n",
+                        TOURNAMENT_MAX_STRATEGIES, STRATEGY_MAX_ORDER);
+                    return 1;}
+
+                strategyFormat(&spec, formatted, sizeof formatted);
+
+                for (int k = 0; k < options->tournamentCount; k++) {
+                    strategyFormat(&options->tournament[k], other, sizeof other);
+
+                    if (strcmp(formatted, other) == 0) {
+                        fprintf(stderr, "--tournament lists %s twice...\n", formatted);
+                        return 1;}}
+
+                options->tournament[options->tournamentCount++] = spec;}
+
+            if (options->tournamentCount < 2) {
+                fprintf(stderr, "--tournament needs at least two strategies...\n");
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--variant") == 0) && (value != NULL)) {
+            options->variant = variantFind(value);
+
+            if (options->variant == NULL) {
+                fprintf(stderr, "--variant expects rps, rpsls or rps101...\n");
+                return 1;}
+
+            // The classic game keeps its art, strategies and every other mode.
+            if (options->variant->id == VARIANT_CLASSIC)
+                options->variant = NULL;
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--moves") == 0) && (value != NULL)) {
+            options->movesPath = value;
+            i++;}
+
+        else if ((strcmp(argv[i], "--threads") == 0) && (value != NULL)) {
+            long threads = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (threads < 0) || (threads > MAX_SIMULATION_THREADS)) {
+                fprintf(stderr, "--threads expects an integer between 0 and %i...\n", MAX_SIMULATION_THREADS);
+                return 1;}
+
+            // 0 means one thread per online CPU.
+            if (threads == 0)
+                threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+            options->threads = (threads > 0) ? (int) threads : 1;
+            i++;}
+
+        else if ((strcmp(argv[i], "--seed") == 0) && (value != NULL)) {
+            options->seed = strtoull(value, &end, 0);
+
+            if ((*end != '\0') || (*value == '-') || (*value == '\0')) {
+                fprintf(stderr, "--seed expects an unsigned 64-bit integer...\n");
+                return 1;}
+
+            options->seedGiven = 1;
+            i++;}
+
+        else if ((strcmp(argv[i], "--rng") == 0) && (value != NULL)) {
+
+            if (strcmp(value, "xoshiro256") == 0)
+                options->rngKind = RNG_XOSHIRO256;
+
+            else if (strcmp(value, "pcg32") == 0)
+                options->rngKind = RNG_PCG32;
+
+            else {
+                fprintf(stderr, "--rng expects 'xoshiro256' or 'pcg32'...\n");
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--simulate") == 0) && (value != NULL)) {
+            options->simulateSeries = strtoll(value, &end, 10);
+
+            if ((*end != '\0') || (options->simulateSeries <= 0)) {
+                fprintf(stderr, "--simulate expects a positive integer...\n");
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--rounds") == 0) && (value != NULL)) {
+            options->simulateRounds = strtoll(value, &end, 10);
+
+            if ((*end != '\0') || (options->simulateRounds <= 0)) {
+                fprintf(stderr, "--rounds expects a positive integer...\n");
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--kernel") == 0) && (value != NULL)) {
+            options->kernel = batchKernelFind((strcmp(value, "auto") == 0) ? NULL : value);
+
+            if ((options->kernel == NULL) || !options->kernel->available()) {
+                fprintf(stderr, "Kernel '%s' is not available on this CPU...\n", value);
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--best-of") == 0) && (value != NULL)) {
+            long bestOf = strtol(value, &end, 10);
+
+            // Same rule as the interactive 'Best of' prompt.
+            if ((*end != '\0') || (bestOf <= 0) || (bestOf % 2 == 0) || (bestOf > 999)) {
+                fprintf(stderr, "--best-of expects a positive odd integer...\n");
+                return 1;}
+
+            options->simulateBestOf = (int) bestOf;
+            i++;}
 
-        else if (strcmp(tempPlayerChoice, "scissors") == 0)
-            return 3;
-        
         else {
-            // Invalid input, prompt again.
-            printf("Invalid Choice...\n");
-            usleep(UI_MICRO_DELAY_SHORT);}}
+            fprintf(stderr, "Unknown or incomplete option: %s\n", argv[i]);
+            printUsage(stderr, argv[0]);
+            return 1;}}
 
-    // If loop exits, it means max attempts were exceeded.
-    printf("Too many invalid inputs...\n");
-    exit(1);}   // Terminate program with error status
+    // Everything else (art, strategies, logs, the server, the batch kernels) assumes three moves.
+    if ((options->variant != NULL) && ((options->servePort != 0) || (options->movesPath != NULL) || (options->logPath != NULL) || (options->simulateRounds > 0)
+            || options->simulateCompare || (options->computerStrategy.kind != STRATEGY_RANDOM) || (options->playerStrategy.kind != STRATEGY_RANDOM))) {
+        fprintf(stderr, "--variant only works with the interactive game and --simulate between random players...\n");
+        return 1;}
+
+    if ((options->serveCompressed || (options->webPort != 0)) && (options->servePort == 0)) {
+        fprintf(stderr, "--compress and --web only apply to --serve...\n");
+        return 1;}
+
+    // Headless modes have no prompt to time.
+    if (options->timeStartup && ((options->servePort != 0) || (options->movesPath != NULL) || (options->simulateSeries > 0) || (options->simulateRounds > 0)
+            || (options->tournamentCount > 0))) {
+        fprintf(stderr, "--time-startup only applies to the game on the terminal...\n");
+        return 1;}
+
+    // Only a best-of series of the classic game, on the terminal or the server, is checkpointed.
+    if ((options->checkpointPath != NULL) && ((options->movesPath != NULL) || (options->simulateSeries > 0) || (options->simulateRounds > 0)
+            || (options->tournamentCount > 0) || (options->variant != NULL))) {
+        fprintf(stderr, "--checkpoint only applies to the classic game on the terminal or with --serve...\n");
+        return 1;}
+
+    if ((options->webPort != 0) && (options->webPort == options->servePort)) {
+        fprintf(stderr, "--web needs a port of its own...\n");
+        return 1;}
+
+    // The tournament's list replaces the two sides' strategies.
+    if ((options->tournamentCount > 0) && ((options->servePort != 0) || (options->movesPath != NULL) || (options->logPath != NULL) || (options->simulateRounds > 0)
+            || options->simulateCompare || (options->variant != NULL) || (options->computerStrategy.kind != STRATEGY_RANDOM) || (options->playerStrategy.kind != STRATEGY_RANDOM))) {
+        fprintf(stderr, "--tournament only combines with --simulate, --best-of, --threads, --seed and --rng...\n");
+        return 1;}
+
+    return 0;}
+
+void printUsage(FILE *stream, const char *program) {
 
-void clearInputBuffer(){
-    int a;
-    while (((a = getchar()) != '\n') && (a != EOF));}
\ No newline at end of file
+    fprintf(stream, "Usage: %s [options]\n\n", program);
+    fprintf(stream, "Without options an interactive game is started.\n\n");
+    fprintf(stream, "Options:\n");
+    fprintf(stream, "  --speed F      Animation speed multiplier: 2 is twice as fast, 0 is instant (default 1)\n");
+    fprintf(stream, "  --no-delay     Same as --speed 0\n");
+    fprintf(stream, "  --font FILE    figlet (.flf) font for the final banner (default: built-in font)\n");
+    fprintf(stream, "  --figlet       Draw the final banner with the external figlet program\n");
+    fprintf(stream, "  --in-place     On a terminal, keep the round art at the top and redraw only what changed\n");
+    fprintf(stream, "  --serve PORT   Host games for many players at once over TCP instead of playing locally\n");
+    fprintf(stream, "  --web PORT     Also serve a browser client on PORT, playing over a WebSocket\n");
+    fprintf(stream, "  --compress     Offer the server's telnet clients MCCP2 compression, with precompressed frames\n");
+    fprintf(stream, "  --stats        Time every phase (think, render, sleep, output, banner) and print p50/p99 at exit\n");
+    fprintf(stream, "  --time-startup Report the time from exec to the first prompt on stderr\n");
+    fprintf(stream, "  --simulate N   Play N best-of series headlessly and print aggregate counts\n");
+    fprintf(stream, "  --moves FILE   Play the moves in FILE (text or packed) at full speed and log every round\n");
+    fprintf(stream, "  --log FILE     Append every game (or replayed series) to the binary match log FILE\n");
+    fprintf(stream, "  --checkpoint FILE  Keep the series in progress in FILE and resume it after a crash or restart\n");
+    fprintf(stream, "  --variant V    Game variant: rps (default), rpsls (with Spock and Lizard) or rps101\n");
+    fprintf(stream, "  --strategy S   Computer's strategy: random (default), frequency, markov[1-%i], ensemble or cycle\n", STRATEGY_MAX_ORDER);
+    fprintf(stream, "  --player-strategy S  Player's strategy in the simulator (default random)\n");
+    fprintf(stream, "  --tournament LIST  Round robin of the comma-separated strategies, --simulate series per pairing (default %i)\n", TOURNAMENT_DEFAULT_SERIES);
+    fprintf(stream, "  --best-of B    'Best-of' length of every simulated or replayed series (default %i)\n", SIMULATE_DEFAULT_BEST_OF);
+    fprintf(stream, "  --rounds N     Resolve N independent rounds with the vectorised batch kernel\n");
+    fprintf(stream, "  --kernel NAME  Batch kernel: auto (default), avx2, sse2, neon or scalar\n");
+    fprintf(stream, "  --compare      Also time the branchy resolver (or scalar kernel) and report the speed-up\n");
+    fprintf(stream, "  --threads T    Split the simulated series, or the server's connections, across T threads (0: one per CPU)\n");
+    fprintf(stream, "  --seed S       Seed of the random number generator (default: clock and pid)\n");
+    fprintf(stream, "  --rng NAME     Random number generator: xoshiro256 (default) or pcg32\n");
+    fprintf(stream, "  -h, --help     Show this help and exit\n");}
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-art.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: ASCII art of the moves and the 'VS' separator.
+ */
+
+# include <string.h>    // String manipulation functions (strcmp)
+# include "sps-art.h"   // Art types and prototypes
+
+// A line of art with its length taken from the literal itself; a line longer than ART_LINE_MAX is a negative array size.
+#define ART_LINE(text) {text, sizeof (text) - 1 + 0 * sizeof (char [ART_LINE_MAX + 1 - sizeof (text)])}
+
+// Table generated from art/*.txt: artIndex, one entry of lines per file.
+#include "sps-art-data.h"
+
+const Art *artFind(const char *name) {
+
+    for (size_t i = 0; i < sizeof artIndex / sizeof artIndex[0]; i++)
+        if (strcmp(artIndex[i].name, name) == 0)
+            return &artIndex[i];
+
+    return NULL;}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-art.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: ASCII art of the moves and the 'VS' separator. Every art is
+ * a text file art/NAME.txt of ART_HEIGHT lines, turned into a static table
+ * of lines and their lengths by the Makefile (sps-art-data.h), so new art
+ * only needs a new file. The tables hold no pointers: they are plain
+ * read-only data that needs no relocation when the program starts.
+ */
+
+#ifndef SPS_ART_H
+#define SPS_ART_H
+
+# include <stddef.h>    // size_t
+
+// Define constants for the ASCII art
+#define ART_HEIGHT 20   // Height of each ASCII art in lines.
+#define ART_LINE_MAX 80 // Longest line of an art file, in bytes.
+#define ART_NAME_MAX 16 // Room for the name of an art file, null terminator included.
+
+// Data types
+/**
+ * @brief One line of an art, without its newline.
+ */
+typedef struct {
+    char text[ART_LINE_MAX];    // Characters of the line (not null-terminated)
+    size_t length;              // Bytes of text, known at compile time
+} ArtLine;
+
+/**
+ * @brief An art and the name of the file it was generated from.
+ */
+typedef struct {
+    char name[ART_NAME_MAX];    // File name without the directory and '.txt' (e.g. "stone")
+    ArtLine lines[ART_HEIGHT];  // One per line of the file
+} Art;
+
+// Function prototypes
+/**
+ * @brief Looks an art up by name.
+ *
+ * @param name Name of the art ("stone", "paper", "scissors", "vs", ...).
+ * @return The art, or NULL if there is no art/NAME.txt.
+ */
+const Art *artFind(const char *name);
+
+#endif
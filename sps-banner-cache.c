@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-banner-cache.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Memory-capped LRU cache of rendered result banners. Entries
+ * hang off fixed hash chains and a doubly linked recency list, so a hit is
+ * a hash, a short chain walk and two pointer swaps, and an eviction drops
+ * the tail of the list.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdlib.h>    // Standard library functions (malloc, free)
+# include <string.h>    // String manipulation functions (strlen, memcpy, memcmp, memset)
+# include "sps-banner-cache.h" // Banner cache types and prototypes
+
+/**
+ * @brief FNV-1a hash of a key.
+ */
+static uint64_t bannerCacheHash(const char *name, size_t nameLength, int playerWins, int computerWins, int width) {
+
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (size_t i = 0; i < nameLength; i++)
+        hash = (hash ^ (unsigned char) name[i]) * 1099511628211ULL;
+
+    hash = (hash ^ (uint32_t) playerWins) * 1099511628211ULL;
+    hash = (hash ^ (uint32_t) computerWins) * 1099511628211ULL;
+
+    return (hash ^ (uint32_t) width) * 1099511628211ULL;}
+
+/**
+ * @brief Takes an entry out of the recency list.
+ */
+static void bannerCacheUnlink(BannerCache *cache, BannerCacheEntry *entry) {
+
+    if (entry->newer != NULL)
+        entry->newer->older = entry->older;
+    else
+        cache->newest = entry->older;
+
+    if (entry->older != NULL)
+        entry->older->newer = entry->newer;
+    else
+        cache->oldest = entry->newer;}
+
+/**
+ * @brief Puts an entry at the most recently used end of the list.
+ */
+static void bannerCachePushNewest(BannerCache *cache, BannerCacheEntry *entry) {
+
+    entry->newer = NULL;
+    entry->older = cache->newest;
+
+    if (cache->newest != NULL)
+        cache->newest->newer = entry;
+    else
+        cache->oldest = entry;
+
+    cache->newest = entry;}
+
+/**
+ * @brief Memory an entry holds: its header, name and banner.
+ */
+static size_t bannerCacheEntrySize(size_t nameLength, size_t length) {
+
+    return sizeof(BannerCacheEntry) + nameLength + length;}
+
+/**
+ * @brief Drops the least recently used entry.
+ */
+static void bannerCacheEvictOldest(BannerCache *cache) {
+
+    BannerCacheEntry *entry = cache->oldest;
+    BannerCacheEntry **link = &cache->buckets[entry->hash & (BANNER_CACHE_BUCKETS - 1)];
+
+    while (*link != entry)
+        link = &(*link)->chain;
+
+    *link = entry->chain;
+    bannerCacheUnlink(cache, entry);
+
+    cache->stats.bytes -= bannerCacheEntrySize(entry->nameLength, entry->length);
+    cache->stats.entries--;
+    cache->stats.evictions++;
+    free(entry);}
+
+void bannerCacheInit(BannerCache *cache, size_t capacity) {
+
+    memset(cache, 0, sizeof *cache);
+    cache->stats.capacity = capacity;}
+
+const char *bannerCacheFind(BannerCache *cache, const char *name, int playerWins, int computerWins, int width, size_t *length) {
+
+    size_t nameLength = strlen(name);
+    uint64_t hash = bannerCacheHash(name, nameLength, playerWins, computerWins, width);
+
+    for (BannerCacheEntry *entry = cache->buckets[hash & (BANNER_CACHE_BUCKETS - 1)]; entry != NULL; entry = entry->chain)
+        if ((entry->hash == hash) && (entry->playerWins == playerWins) && (entry->computerWins == computerWins) && (entry->width == width)
+            && (entry->nameLength == nameLength) && (memcmp(entry->data, name, nameLength) == 0)) {
+
+            if (cache->newest != entry) {
+                bannerCacheUnlink(cache, entry);
+                bannerCachePushNewest(cache, entry);}
+
+            cache->stats.hits++;
+            *length = entry->length;
+            return entry->data + nameLength;}
+
+    cache->stats.misses++;
+
+    return NULL;}
+
+int bannerCacheInsert(BannerCache *cache, const char *name, int playerWins, int computerWins, int width, const char *banner, size_t length) {
+
+    size_t nameLength = strlen(name);
+    size_t size = bannerCacheEntrySize(nameLength, length);
+
+    if (size > cache->stats.capacity)
+        return -1;
+
+    while (cache->stats.bytes + size > cache->stats.capacity)
+        bannerCacheEvictOldest(cache);
+
+    BannerCacheEntry *entry = malloc(size);
+
+    if (entry == NULL)
+        return -1;
+
+    *entry = (BannerCacheEntry) {.hash = bannerCacheHash(name, nameLength, playerWins, computerWins, width), .playerWins = playerWins,
+        .computerWins = computerWins, .width = width, .nameLength = nameLength, .length = length};
+    memcpy(entry->data, name, nameLength);
+    memcpy(entry->data + nameLength, banner, length);
+
+    BannerCacheEntry **bucket = &cache->buckets[entry->hash & (BANNER_CACHE_BUCKETS - 1)];
+
+    entry->chain = *bucket;
+    *bucket = entry;
+    bannerCachePushNewest(cache, entry);
+
+    cache->stats.bytes += size;
+    cache->stats.entries++;
+    cache->stats.insertions++;
+
+    return 0;}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-banner-cache.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Memory-capped LRU cache of rendered result banners, keyed by
+ * what the banner depends on: the player's name, both scores and the width.
+ */
+
+#ifndef SPS_BANNER_CACHE_H
+#define SPS_BANNER_CACHE_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint64_t) for key hashes
+
+// Define constants for the banner cache
+#define BANNER_CACHE_BUCKETS 4096   // Hash chains of a cache (a power of two, about its expected entry count).
+
+// Data types
+/**
+ * @brief One cached banner, allocated in one block with its key's name and its bytes.
+ */
+typedef struct BannerCacheEntry {
+    struct BannerCacheEntry *chain;     // Next entry of the same hash chain
+    struct BannerCacheEntry *newer;     // Entry used just after this one, or NULL for the newest
+    struct BannerCacheEntry *older;     // Entry used just before this one, or NULL for the oldest
+    uint64_t hash;                      // Hash of the key
+    int playerWins;                     // Key: the player's score
+    int computerWins;                   // Key: the computer's score
+    int width;                          // Key: width the banner was wrapped at
+    size_t nameLength;                  // Key: length of the player's name
+    size_t length;                      // Bytes of the banner
+    char data[];                        // The name (without terminator), then the banner
+} BannerCacheEntry;
+
+/**
+ * @brief Hit and miss counters of a cache.
+ */
+typedef struct {
+    long long hits;         // Lookups that found their banner
+    long long misses;       // Lookups that did not
+    long long insertions;   // Banners stored
+    long long evictions;    // Banners dropped to make room
+    long long entries;      // Banners held
+    size_t bytes;           // Memory held by the entries
+    size_t capacity;        // Memory the entries may hold
+} BannerCacheStats;
+
+/**
+ * @brief Cache of rendered banners, evicting the least recently used once its memory cap is reached.
+ */
+typedef struct {
+    BannerCacheEntry *buckets[BANNER_CACHE_BUCKETS];    // Hash chains
+    BannerCacheEntry *newest;   // Most recently used entry
+    BannerCacheEntry *oldest;   // Least recently used entry, evicted first
+    BannerCacheStats stats;     // Counters, and the memory used and allowed
+} BannerCache;
+
+// Function prototypes
+/**
+ * @brief Prepares an empty cache.
+ *
+ * @param cache Pointer to the cache to initialize.
+ * @param capacity Memory the entries may hold in bytes, counting their headers and names.
+ */
+void bannerCacheInit(BannerCache *cache, size_t capacity);
+
+/**
+ * @brief Looks a banner up, making it the most recently used; counts a hit or a miss.
+ *
+ * @param cache Cache to look in.
+ * @param name Player's name.
+ * @param playerWins Player's score.
+ * @param computerWins Computer's score.
+ * @param width Width the banner is wrapped at.
+ * @param length Set to the number of bytes of the banner if it is found.
+ * @return The banner, owned by the cache and valid until its next insertion, or NULL on a miss.
+ */
+const char *bannerCacheFind(BannerCache *cache, const char *name, int playerWins, int computerWins, int width, size_t *length);
+
+/**
+ * @brief Stores a copy of a banner that bannerCacheFind missed, evicting the least recently used until it fits.
+ *
+ * @param cache Cache to store in.
+ * @param name Player's name.
+ * @param playerWins Player's score.
+ * @param computerWins Computer's score.
+ * @param width Width the banner is wrapped at.
+ * @param banner Rendered banner to copy.
+ * @param length Bytes of the banner.
+ * @return 0 if the banner was stored, -1 if it is larger than the whole cache or memory ran out.
+ */
+int bannerCacheInsert(BannerCache *cache, const char *name, int playerWins, int computerWins, int width, const char *banner, size_t length);
+
+#endif
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-banner.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Built-in renderer for figlet (.flf) fonts, used to draw the final
+ * win/loss banner.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (sscanf)
+# include <stdlib.h>    // Standard library functions (malloc, realloc, free)
+# include <string.h>    // String manipulation functions (memcpy, memchr, memset)
+# include <ctype.h> // Character handling functions (isspace)
+# include <unistd.h>    // POSIX operating system API (close)
+# include <sys/mman.h>  // POSIX memory mapping (mmap) for loading banner fonts
+# include <sys/stat.h>  // POSIX file status (fstat) for sizing font mappings
+# include <fcntl.h> // POSIX file control (open)
+# include "sps-banner.h"    // Banner types and prototypes
+
+// Define constants for the banner renderer
+#define BANNER_HEADER_BUFFER 256    // Longest font header line parsed.
+
+// Data types
+/**
+ * @brief A banner line being assembled, one buffer per font row.
+ */
+typedef struct {
+    char rows[BANNER_MAX_FONT_HEIGHT][BANNER_MAX_WIDTH + 1];
+    int length;         // Columns used, the same on every row
+    int previousWidth;  // Width of the last glyph added (the smushing rules need it)
+} BannerLine;
+
+/**
+ * @brief Growing buffer holding rendered banner bytes.
+ */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} BannerOutput;
+
+// Font compiled into the binary from fonts/sps-block.flf (see the Makefile).
+static const char bannerEmbeddedFont[] =
+#include "banner-font.h"
+;
+
+/**
+ * @brief Returns the next line of a font file and advances the cursor past it.
+ *
+ * @return 0 if a line was found, -1 at the end of the data.
+ */
+static int bannerNextLine(const char **cursor, const char *end, const char **line, size_t *length) {
+
+    if (*cursor >= end)
+        return -1;
+
+    const char *newline = memchr(*cursor, '\n', (size_t) (end - *cursor));
+    const char *lineEnd = (newline != NULL) ? newline : end;
+
+    *line = *cursor;
+    *length = (size_t) (lineEnd - *cursor);
+    *cursor = (newline != NULL) ? newline + 1 : end;
+
+    if ((*length > 0) && ((*line)[*length - 1] == '\r'))
+        (*length)--;
+
+    return 0;}
+
+int bannerParseFont(BannerFont *font, const char *data, size_t size) {
+
+    const char *cursor = data, *end = data + size, *line;
+    size_t length;
+    char header[BANNER_HEADER_BUFFER];
+    int baseline, maxLength, oldLayout, commentLines, printDirection, fullLayout = -1;
+
+    memset(font, 0, sizeof *font);
+
+    if ((bannerNextLine(&cursor, end, &line, &length) != 0) || (length < 6) || (memcmp(line, "flf2a", 5) != 0))
+        return -1;
+
+    // Header: flf2a<hardblank> height baseline max_length old_layout comment_lines [print_direction full_layout ...]
+    if (length >= sizeof header)
+        length = sizeof header - 1;
+
+    memcpy(header, line, length);
+    header[length] = '\0';
+
+    int fields = sscanf(header + 6, "%i %i %i %i %i %i %i", &font->height, &baseline, &maxLength, &oldLayout, &commentLines, &printDirection, &fullLayout);
+
+    if ((fields < 5) || (font->height < 1) || (font->height > BANNER_MAX_FONT_HEIGHT) || (commentLines < 0))
+        return -1;
+
+    font->hardblank = header[5];
+
+    // The full layout, when present, supersedes the old one.
+    if (fields >= 7)
+        font->layout = fullLayout;
+
+    else if (oldLayout == 0)
+        font->layout = BANNER_LAYOUT_KERN;
+
+    else if (oldLayout > 0)
+        font->layout = (oldLayout & 31) | BANNER_LAYOUT_SMUSH;
+
+    else
+        font->layout = 0;   // Full width
+
+    for (int i = 0; i < commentLines; i++)
+        if (bannerNextLine(&cursor, end, &line, &length) != 0)
+            return -1;
+
+    // The required characters, code points 32 to 126, follow in order.
+    for (int c = 0; c < BANNER_GLYPH_COUNT; c++) {
+
+        BannerGlyph *glyph = &font->glyphs[c];
+
+        for (int row = 0; row < font->height; row++) {
+
+            if (bannerNextLine(&cursor, end, &line, &length) != 0)
+                return (c > 0) ? 0 : -1;    // A truncated font keeps the glyphs read so far
+
+            // Strip trailing whitespace, then the run of end marks.
+            while ((length > 0) && isspace((unsigned char) line[length - 1]))
+                length--;
+
+            if (length > 0) {
+                char endMark = line[length - 1];
+
+                while ((length > 0) && (line[length - 1] == endMark))
+                    length--;}
+
+            glyph->rows[row] = line;
+            glyph->lengths[row] = (unsigned short) ((length < BANNER_MAX_WIDTH) ? length : BANNER_MAX_WIDTH);}
+
+        glyph->width = glyph->lengths[0];
+        glyph->present = 1;}
+
+    return 0;}
+
+// Font used for every banner, parsed once on first use.
+static BannerFont bannerFont;
+static int bannerFontLoaded;
+
+const BannerFont *bannerLoadFont(const char *path) {
+
+    if (bannerFontLoaded)
+        return &bannerFont;
+
+    if (path != NULL) {
+        int fd = open(path, O_RDONLY);
+        struct stat info;
+        void *data = MAP_FAILED;
+
+        if ((fd >= 0) && (fstat(fd, &info) == 0) && (info.st_size > 0))
+            data = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (fd >= 0)
+            close(fd);
+
+        // The mapping stays in place for the lifetime of the process: the glyphs point into it.
+        if ((data != MAP_FAILED) && (bannerParseFont(&bannerFont, data, (size_t) info.st_size) == 0)) {
+            bannerFontLoaded = 1;
+            return &bannerFont;}
+
+        if (data != MAP_FAILED)
+            munmap(data, (size_t) info.st_size);
+
+        fprintf(stderr, "Could not load font '%s', using the built-in font...\n", path);}
+
+    if (bannerParseFont(&bannerFont, bannerEmbeddedFont, sizeof bannerEmbeddedFont - 1) != 0)
+        return NULL;
+
+    bannerFontLoaded = 1;
+
+    return &bannerFont;}
+
+/**
+ * @brief Combines two overlapping characters following the font's smushing rules.
+ *
+ * Mirrors figlet's rules: universal smushing, or the equal character,
+ * underscore, hierarchy, opposite pair, big X and hardblank rules.
+ *
+ * @return The combined character, or '\0' if the two cannot be smushed.
+ */
+static char bannerSmush(const BannerFont *font, const BannerLine *line, int glyphWidth, char left, char right) {
+
+    static const char *hierarchy[] = {"|", "/\\", "[]", "{}", "()", "<>"};
+    char hardblank = font->hardblank;
+    int layout = font->layout;
+
+    if (left == ' ')
+        return right;
+
+    if (right == ' ')
+        return left;
+
+    if ((line->previousWidth < 2) || (glyphWidth < 2))
+        return '\0';
+
+    if ((layout & BANNER_LAYOUT_SMUSH) == 0)
+        return '\0';
+
+    if ((layout & 63) == 0) {   // Universal smushing: the right character wins, hardblanks give way
+        if (left == hardblank)
+            return right;
+
+        return (right == hardblank) ? left : right;}
+
+    if ((layout & BANNER_RULE_HARDBLANK) && (left == hardblank) && (right == hardblank))
+        return left;
+
+    if ((left == hardblank) || (right == hardblank))
+        return '\0';
+
+    if ((layout & BANNER_RULE_EQUAL) && (left == right))
+        return left;
+
+    if (layout & BANNER_RULE_UNDERSCORE) {
+        if ((left == '_') && strchr("|/\\[]{}()<>", right))
+            return right;
+
+        if ((right == '_') && strchr("|/\\[]{}()<>", left))
+            return left;}
+
+    if (layout & BANNER_RULE_HIERARCHY)
+        for (int i = 0; i < 6; i++)
+            for (int j = i + 1; j < 6; j++) {
+                if (strchr(hierarchy[i], left) && strchr(hierarchy[j], right))
+                    return right;
+
+                if (strchr(hierarchy[i], right) && strchr(hierarchy[j], left))
+                    return left;}
+
+    if (layout & BANNER_RULE_PAIR) {
+        static const char *pairs[] = {"[]", "][", "{}", "}{", "()", ")("};
+
+        for (int i = 0; i < 6; i++)
+            if ((left == pairs[i][0]) && (right == pairs[i][1]))
+                return '|';}
+
+    if (layout & BANNER_RULE_BIG_X) {
+        if ((left == '/') && (right == '\\'))
+            return '|';
+
+        if ((left == '\\') && (right == '/'))
+            return 'Y';
+
+        if ((left == '>') && (right == '<'))
+            return 'X';}
+
+    return '\0';}
+
+/**
+ * @brief Returns how many columns a glyph can overlap the end of the line.
+ */
+static int bannerOverlap(const BannerFont *font, const BannerLine *line, const BannerGlyph *glyph) {
+
+    if ((font->layout & (BANNER_LAYOUT_SMUSH | BANNER_LAYOUT_KERN)) == 0)
+        return 0;
+
+    int overlap = glyph->width;
+
+    for (int row = 0; row < font->height; row++) {
+
+        int lineEdge = line->length;  // Last non-blank column of the line
+        int glyphEdge = 0;  // First non-blank column of the glyph
+        char left = '\0', right;
+
+        while ((lineEdge > 0) && (((left = line->rows[row][lineEdge]) == '\0') || (left == ' ')))
+            lineEdge--;
+
+        if (lineEdge == 0)
+            left = line->rows[row][0];
+
+        while ((glyphEdge < glyph->lengths[row]) && (glyph->rows[row][glyphEdge] == ' '))
+            glyphEdge++;
+
+        right = (glyphEdge < glyph->lengths[row]) ? glyph->rows[row][glyphEdge] : '\0';
+
+        int amount = glyphEdge + line->length - 1 - lineEdge;
+
+        if ((left == '\0') || (left == ' '))
+            amount++;
+
+        else if ((right != '\0') && (bannerSmush(font, line, glyph->width, left, right) != '\0'))
+            amount++;
+
+        if (amount < overlap)
+            overlap = amount;}
+
+    return (overlap > 0) ? overlap : 0;}
+
+/**
+ * @brief Appends the glyph of one character to a banner line.
+ *
+ * @return 0 on success, -1 if the line would become wider than the limit.
+ */
+static int bannerAddChar(const BannerFont *font, BannerLine *line, unsigned char c, int limit) {
+
+    if ((c < 32) || (c >= 32 + BANNER_GLYPH_COUNT) || !font->glyphs[c - 32].present)
+        return 0;   // Characters the font lacks are skipped, as figlet does
+
+    const BannerGlyph *glyph = &font->glyphs[c - 32];
+    int overlap = bannerOverlap(font, line, glyph);
+
+    if (line->length + glyph->width - overlap > limit)
+        return -1;
+
+    for (int row = 0; row < font->height; row++) {
+
+        int column = line->length - overlap;
+
+        for (int k = 0; k < glyph->width; k++, column++) {
+
+            char right = (k < glyph->lengths[row]) ? glyph->rows[row][k] : ' ';
+
+            if (column < 0)
+                continue;
+
+            line->rows[row][column] = (column < line->length) ? bannerSmush(font, line, glyph->width, line->rows[row][column], right) : right;}
+
+        line->rows[row][column] = '\0';}
+
+    line->length += glyph->width - overlap;
+    line->previousWidth = glyph->width;
+
+    return 0;}
+
+/**
+ * @brief Appends bytes to a growing banner output buffer.
+ */
+static int bannerAppend(BannerOutput *output, const char *data, size_t length) {
+
+    if (output->length + length > output->capacity) {
+        size_t capacity = (output->capacity == 0) ? 4096 : output->capacity;
+
+        while (capacity < output->length + length)
+            capacity *= 2;
+
+        char *buffer = realloc(output->data, capacity);
+
+        if (buffer == NULL)
+            return -1;
+
+        output->data = buffer;
+        output->capacity = capacity;}
+
+    memcpy(output->data + output->length, data, length);
+    output->length += length;
+
+    return 0;}
+
+/**
+ * @brief Writes a finished banner line (every row, hardblanks shown as spaces) and clears it.
+ */
+static int bannerFlushLine(const BannerFont *font, BannerLine *line, BannerOutput *output) {
+
+    for (int row = 0; row < font->height; row++) {
+
+        for (int k = 0; k < line->length; k++)
+            if (line->rows[row][k] == font->hardblank)
+                line->rows[row][k] = ' ';
+
+        line->rows[row][line->length] = '\n';
+
+        if (bannerAppend(output, line->rows[row], (size_t) line->length + 1) != 0)
+            return -1;
+
+        line->rows[row][0] = '\0';}
+
+    line->length = 0;
+    line->previousWidth = 0;
+
+    return 0;}
+
+char *bannerRender(const BannerFont *font, const char *message, int width, size_t *length) {
+
+    BannerOutput output = {0};
+    BannerLine *line = calloc(2, sizeof *line);  // The line being built and a scratch copy for word wrapping
+    int limit = ((width > 1) && (width <= BANNER_MAX_WIDTH)) ? width - 1 : BANNER_MAX_WIDTH - 1;    // figlet keeps one column free
+    int failed = (line == NULL);
+
+    for (const char *p = message; !failed; ) {
+
+        // Leading spaces and the word after them are added as one unit, so a word is never split while it fits on a line.
+        const char *wordStart = p + strspn(p, " ");
+        const char *wordEnd = wordStart + strcspn(wordStart, " \n");
+
+        line[1] = line[0];
+
+        int fits = 1;
+
+        for (const char *q = p; fits && (q < wordEnd); q++)
+            fits = (bannerAddChar(font, &line[1], (unsigned char) *q, limit) == 0);
+
+        if (fits)
+            line[0] = line[1];
+
+        else {
+            // Wrap: start a new line with the word, breaking it only if it is wider than a whole line.
+            if ((line[0].length > 0) && (bannerFlushLine(font, &line[0], &output) != 0))
+                failed = 1;
+
+            for (const char *q = wordStart; !failed && (q < wordEnd); q++)
+                if (bannerAddChar(font, &line[0], (unsigned char) *q, limit) != 0) {
+                    failed = (bannerFlushLine(font, &line[0], &output) != 0);
+                    bannerAddChar(font, &line[0], (unsigned char) *q, limit);}}
+
+        p = wordEnd;
+
+        if ((*p == '\n') || (*p == '\0')) {
+            if (!failed && (bannerFlushLine(font, &line[0], &output) != 0))
+                failed = 1;
+
+            if (*p == '\0')
+                break;
+
+            p++;}}
+
+    free(line);
+
+    if (failed) {
+        free(output.data);
+        return NULL;}
+
+    *length = output.length;
+
+    return output.data;}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-banner.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Built-in renderer for figlet (.flf) fonts, used to draw the final
+ * win/loss banner.
+ */
+
+#ifndef SPS_BANNER_H
+#define SPS_BANNER_H
+
+# include <stddef.h>    // size_t
+
+// Define constants for the banner renderer (figlet .flf fonts)
+#define BANNER_MAX_FONT_HEIGHT 16   // Tallest font the renderer accepts, in lines.
+#define BANNER_MAX_WIDTH 512    // Widest banner line the renderer builds, in columns.
+#define BANNER_GLYPH_COUNT 95   // Glyphs read from a font: the required characters 32 to 126.
+#define BANNER_RULE_EQUAL 1 // Smushing rule: equal characters merge.
+#define BANNER_RULE_UNDERSCORE 2    // Smushing rule: an underscore gives way to a border character.
+#define BANNER_RULE_HIERARCHY 4 // Smushing rule: the higher class of | /\ [] {} () <> wins.
+#define BANNER_RULE_PAIR 8  // Smushing rule: opposite brackets merge into '|'.
+#define BANNER_RULE_BIG_X 16    // Smushing rule: /\ becomes '|', \/ becomes 'Y' and >< becomes 'X'.
+#define BANNER_RULE_HARDBLANK 32    // Smushing rule: two hardblanks merge.
+#define BANNER_LAYOUT_KERN 64   // Layout flag: glyphs are moved together until they touch.
+#define BANNER_LAYOUT_SMUSH 128 // Layout flag: glyphs overlap by one column where the rules allow.
+
+// Data types
+/**
+ * @brief One character of a banner font.
+ */
+typedef struct {
+    const char *rows[BANNER_MAX_FONT_HEIGHT];       // Start of each row inside the font data (rows are not null-terminated)
+    unsigned short lengths[BANNER_MAX_FONT_HEIGHT]; // Length of each row without the end marks
+    int width;                                      // Width of the glyph (length of its first row)
+    int present;                                    // Non-zero if the font defines this character
+} BannerGlyph;
+
+/**
+ * @brief A parsed figlet (.flf) font. The glyphs point into the font data, which must stay mapped.
+ */
+typedef struct {
+    char hardblank;     // Character drawn as a space that is never smushed
+    int height;         // Lines per glyph
+    int layout;         // BANNER_RULE_* and BANNER_LAYOUT_* flags (0 is full width)
+    BannerGlyph glyphs[BANNER_GLYPH_COUNT]; // Glyphs of characters 32 to 126
+} BannerFont;
+
+// Function prototypes
+/**
+ * @brief Parses figlet (.flf) font data.
+ *
+ * The glyphs keep pointers into the data instead of copying it.
+ *
+ * @param font Pointer to the font to fill in.
+ * @param data Font file contents (need not be null-terminated).
+ * @param size Number of bytes of data.
+ * @return 0 on success, -1 if the data is not a usable figlet font.
+ */
+int bannerParseFont(BannerFont *font, const char *data, size_t size);
+
+/**
+ * @brief Returns the banner font, loading it on first use.
+ *
+ * A font file is mapped with mmap and kept mapped; if it cannot be loaded,
+ * the font compiled into the binary is used instead.
+ *
+ * @param path figlet font file, or NULL for the built-in font.
+ * @return Pointer to the cached font, or NULL if no font could be parsed.
+ */
+const BannerFont *bannerLoadFont(const char *path);
+
+/**
+ * @brief Renders a message with a figlet font, wrapping words at the given width like figlet -w.
+ *
+ * Newlines in the message start a new banner line.
+ *
+ * @param font Font to render with.
+ * @param message Text to render.
+ * @param width Output width in columns.
+ * @param length Set to the number of bytes rendered.
+ * @return A malloc'd buffer with the rendered rows (not null-terminated), or NULL on allocation failure.
+ */
+char *bannerRender(const BannerFont *font, const char *message, int width, size_t *length);
+
+#endif
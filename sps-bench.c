@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-bench.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Micro-benchmarks of the game's hot paths, run with 'make bench'.
+ * Measures rounds per second of both round resolvers, every batch kernel the
+ * CPU supports and the multi-threaded simulator, plus frames per second of
+ * asciiArtPrinter writing to /dev/null, and banners per second rendered or
+ * served from the banner cache. Every benchmark is run a number of
+ * warm-up repetitions first, then timed repetitions; the results are printed
+ * to stdout as JSON.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (printf, fprintf)
+# include <stdlib.h>    // Standard library functions (malloc, qsort, strtol, strtod)
+# include <string.h>    // String manipulation functions (strcmp)
+# include <time.h>  // Time functions (clock_gettime) for timing repetitions
+# include <unistd.h>    // POSIX operating system API (sysconf, close)
+# include <fcntl.h> // POSIX file control (open) for /dev/null
+# include "sps-art.h" // ASCII art of the moves
+# include "sps-engine.h"    // Round resolution, random numbers and the simulator
+# include "sps-terminal.h"  // Output buffer, animations and round frames
+# include "sps-metrics.h"   // Phase histograms
+# include "sps-banner.h"    // Built-in figlet font renderer
+# include "sps-banner-cache.h" // Rendered result banners
+
+// Define constants for the benchmark
+#define BENCH_DEFAULT_WARMUP 3  // Untimed repetitions run before each benchmark.
+#define BENCH_DEFAULT_REPETITIONS 21    // Timed repetitions of each benchmark.
+#define BENCH_MAX_REPETITIONS 10000 // Upper bound accepted by '--warmup' and '--repetitions'.
+#define BENCH_MAX_SCALE 1000    // Upper bound accepted by '--scale'.
+#define BENCH_MAX_THREADS 1024  // Upper bound accepted by '--threads'.
+#define BENCH_SEED 20250510 // Seed of every benchmark, so repetitions do identical work.
+#define BENCH_SERIES 200000 // Best-of series per repetition of the resolver and simulator benchmarks.
+#define BENCH_BEST_OF 3 // 'Best-of' length of the benchmarked series.
+#define BENCH_ROUNDS 20000000   // Independent rounds per repetition of the batch benchmarks.
+#define BENCH_FRAMES 20000  // Round frames printed per repetition of the frame benchmark.
+#define BENCH_METRICS 10000000  // Values recorded per repetition of the metrics benchmarks.
+#define BENCH_BANNERS 20000 // Banners rendered per repetition of the banner benchmarks (looked up: 100 times as many).
+#define BENCH_BANNER_NAMES 1000 // Distinct player names of the banner benchmarks, each at 2:0 and 0:2.
+#define BENCH_BANNER_WIDTH 180  // Width of the benchmarked banners (the game's COMBINED_ART_WIDTH).
+
+// Data types
+/**
+ * @brief Options collected from the benchmark's command line.
+ */
+typedef struct {
+    int warmup;         // Untimed repetitions per benchmark
+    int repetitions;    // Timed repetitions per benchmark
+    double scale;       // Multiplier applied to the work of every repetition
+    int threads;        // Threads of the multi-threaded simulator
+} BenchOptions;
+
+/**
+ * @brief One benchmark: a name, its unit and a function running one repetition.
+ *
+ * run() does one repetition of work and returns the number of units done
+ * (rounds or frames), which must be the same for every repetition.
+ */
+typedef struct {
+    const char *name;           // Name reported in the JSON output
+    const char *unit;           // Unit of the reported rates
+    int threads;                // Threads used by the benchmark
+    long long (*run)(const void *context, double scale);
+    const void *context;        // Argument passed to run()
+} Benchmark;
+
+// Function prototypes
+/**
+ * @brief Runs one benchmark and prints its result as a JSON object.
+ *
+ * The median and p99 are computed over the timed repetitions with the
+ * nearest-rank method. Both are reported as a rate: p99 is the rate of the
+ * 99th percentile repetition time, i.e. the slow tail.
+ *
+ * @param benchmark Benchmark to run.
+ * @param options Pointer to the parsed command line options.
+ * @param first Non-zero for the first benchmark printed (no separating comma).
+ * @return 0 on success, 1 on failure.
+ */
+int runBenchmark(const Benchmark *benchmark, const BenchOptions *options, int first);
+
+/**
+ * @brief Parses the command line into a BenchOptions structure.
+ *
+ * @param argc Argument count as received by main().
+ * @param argv Argument vector as received by main().
+ * @param options Pointer to the structure to fill in.
+ * @return 0 on success, 1 if the arguments are invalid, -1 if usage was requested.
+ */
+int parseBenchOptions(int argc, char *argv[], BenchOptions *options);
+
+/**
+ * @brief Prints the command line usage to the given stream.
+ *
+ * @param stream Output stream (stdout or stderr).
+ * @param program Name the program was invoked with.
+ */
+void printBenchUsage(FILE *stream, const char *program);
+
+/**
+ * @brief One repetition: plays series on the calling thread with the given resolver.
+ */
+static long long benchResolver(const void *context, double scale) {
+
+    Rng rng;
+    SimulationResult result = {0};
+
+    rngInit(&rng, RNG_XOSHIRO256, BENCH_SEED, 0);
+    simulateSeries((long long) (BENCH_SERIES * scale), BENCH_BEST_OF, *(int (* const *)(int, int)) context, &rng, &result);
+
+    return result.playerRounds + result.computerRounds + result.ties;}
+
+/**
+ * @brief One repetition: resolves independent rounds on the calling thread with the given batch kernel.
+ */
+static long long benchBatchKernel(const void *context, double scale) {
+
+    BatchRng rng;
+    SimulationResult result = {0};
+    long long rounds = (long long) (BENCH_ROUNDS * scale);
+
+    batchRngInit(&rng, BENCH_SEED, 0);
+    simulateRounds(rounds, context, &rng, &result);
+
+    return rounds;}
+
+/**
+ * @brief One repetition: plays a simulation job on its worker threads.
+ */
+static long long benchSimulator(const void *context, double scale) {
+
+    SimulationJob job = *(const SimulationJob *) context;
+    SimulationResult result = {0};
+
+    job.series = (long long) ((double) job.series * scale);
+    job.rounds = (long long) ((double) job.rounds * scale);
+
+    if (runSimulationJob(&job, &result) < 0)
+        return -1;
+
+    return (job.kernel != NULL) ? job.rounds : result.playerRounds + result.computerRounds + result.ties;}
+
+/**
+ * @brief One repetition: prints round frames with asciiArtPrinter, flushing every frame like the game does.
+ */
+static long long benchFrames(const void *context, double scale) {
+
+    const RoundFrame (*frames)[3] = context;
+    long long count = (long long) (BENCH_FRAMES * scale);
+
+    for (long long i = 0; i < count; i++) {
+        asciiArtPrinter(&frames[i % 3][(i / 3) % 3]);
+        animationDrain();}
+
+    return count;}
+
+/**
+ * @brief One repetition: records values in a phase histogram, reading the clock for each if the context says so.
+ */
+static long long benchMetrics(const void *context, double scale) {
+
+    int timed = *(const int *) context;
+    long long count = (long long) (BENCH_METRICS * scale);
+
+    if (timed)
+        for (long long i = 0; i < count; i++)
+            metricsStop(METRIC_RENDER, metricsStart());
+
+    else
+        for (long long i = 0; i < count; i++)
+            metricsRecord(METRIC_RENDER, (uint64_t) i * 2654435761u >> 20);    // Spread over many buckets
+
+    return count;}
+
+/**
+ * @brief Formats the name of banner i of the banner benchmarks and returns its scores.
+ */
+static void benchBannerKey(long long i, char *name, size_t size, int *playerWins, int *computerWins) {
+
+    snprintf(name, size, "Player%lld", i % BENCH_BANNER_NAMES);
+    *playerWins = ((i / BENCH_BANNER_NAMES) & 1) ? 0 : 2;
+    *computerWins = 2 - *playerWins;}
+
+/**
+ * @brief One repetition: renders result banners with the built-in font, as the server does on a cache miss.
+ */
+static long long benchBannerRender(const void *context, double scale) {
+
+    const BannerFont *font = context;
+    long long count = (long long) (BENCH_BANNERS * scale);
+
+    for (long long i = 0; i < count; i++) {
+        char name[32], message[128];
+        int playerWins, computerWins;
+        size_t length;
+
+        benchBannerKey(i, name, sizeof name, &playerWins, &computerWins);
+        formatWinMessage(message, sizeof message, name, playerWins, computerWins);
+        free(bannerRender(font, message, BENCH_BANNER_WIDTH, &length));}
+
+    return count;}
+
+/**
+ * @brief One repetition: looks result banners up in a cache holding all of them, as the server does on a hit.
+ */
+static long long benchBannerCache(const void *context, double scale) {
+
+    BannerCache *cache = (BannerCache *) context;
+    long long count = (long long) (BENCH_BANNERS * 100 * scale);
+    size_t total = 0;
+
+    for (long long i = 0; i < count; i++) {
+        char name[32];
+        int playerWins, computerWins;
+        size_t length = 0;
+
+        benchBannerKey(i, name, sizeof name, &playerWins, &computerWins);
+        total += (bannerCacheFind(cache, name, playerWins, computerWins, BENCH_BANNER_WIDTH, &length) != NULL) ? length : 0;}
+
+    return (total > 0) ? count : -1;}
+
+/**
+ * @brief Orders repetition times for qsort.
+ */
+static int compareSeconds(const void *a, const void *b) {
+
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);}
+
+/**
+ * @brief Returns the nearest-rank percentile of sorted samples.
+ */
+static double percentile(const double *sorted, int count, int percent) {
+
+    int rank = (percent * count + 99) / 100;
+
+    return sorted[(rank > 0) ? rank - 1 : 0];}
+
+int main(int argc, char *argv[]) {
+
+    BenchOptions options;   // Options collected from the command line
+    int parseResult = parseBenchOptions(argc, argv, &options);
+
+    if (parseResult == -1)  // Usage was requested
+        return 0;
+
+    if (parseResult != 0)
+        return 1;
+
+    // Frames are printed for real, but to /dev/null, with every animation delay disabled.
+    int devNull = open("/dev/null", O_WRONLY);
+
+    if (devNull < 0) {
+        perror("Could not open /dev/null");
+        return 1;}
+
+    const Art *moveArts[3] = {artFind("stone"), artFind("paper"), artFind("scissors")};
+    RoundFrame roundFrames[3][3];
+
+    if (buildRoundFrames(moveArts, artFind("vs"), roundFrames) != 0) {
+        perror("Could not build the round frames");
+        return 1;}
+
+    outputSetDescriptor(devNull);
+    animationSetSpeed(0);
+
+    SimulationJob seriesJob = {.series = BENCH_SERIES, .bestOf = BENCH_BEST_OF, .resolver = resolveRound, .seed = BENCH_SEED, .rngKind = RNG_XOSHIRO256, .threads = options.threads};
+    SimulationJob batchJob = {.rounds = BENCH_ROUNDS, .kernel = batchKernelFind(NULL), .seed = BENCH_SEED, .threads = options.threads};
+
+    static int (*const resolvers[2])(int, int) = {resolveRoundBranchy, resolveRound};
+    Benchmark benchmarks[16];
+    int count = 0;
+
+    benchmarks[count++] = (Benchmark) {"resolver_branchy", "rounds/s", 1, benchResolver, &resolvers[0]};
+    benchmarks[count++] = (Benchmark) {"resolver_table", "rounds/s", 1, benchResolver, &resolvers[1]};
+
+    // Every batch kernel compiled in and supported by this CPU.
+    static const char *kernelNames[] = {"avx2", "sse2", "neon", "scalar"};
+    static char kernelBenchNames[4][32];
+
+    for (int i = 0; i < 4; i++) {
+
+        const BatchKernel *kernel = batchKernelFind(kernelNames[i]);
+
+        if ((kernel == NULL) || !kernel->available())
+            continue;
+
+        snprintf(kernelBenchNames[i], sizeof kernelBenchNames[i], "batch_%s", kernel->name);
+        benchmarks[count++] = (Benchmark) {kernelBenchNames[i], "rounds/s", 1, benchBatchKernel, kernel};}
+
+    benchmarks[count++] = (Benchmark) {"simulator_series", "rounds/s", options.threads, benchSimulator, &seriesJob};
+    benchmarks[count++] = (Benchmark) {"simulator_batch", "rounds/s", options.threads, benchSimulator, &batchJob};
+    benchmarks[count++] = (Benchmark) {"ascii_art_printer", "frames/s", 1, benchFrames, roundFrames};
+
+    // Recording alone, then a whole timed phase (two clock reads and a record).
+    static const int metricsTimed[2] = {0, 1};
+
+    metricsEnable();
+    benchmarks[count++] = (Benchmark) {"metrics_record", "records/s", 1, benchMetrics, &metricsTimed[0]};
+    benchmarks[count++] = (Benchmark) {"metrics_phase", "phases/s", 1, benchMetrics, &metricsTimed[1]};
+
+    // Every banner of the lookups is cached first; the cache is large enough that none is evicted.
+    const BannerFont *font = bannerLoadFont(NULL);
+    static BannerCache bannerCache;
+
+    bannerCacheInit(&bannerCache, (size_t) 64 << 20);
+
+    for (long long i = 0; (font != NULL) && (i < 2 * BENCH_BANNER_NAMES); i++) {
+        char name[32], message[128];
+        int playerWins, computerWins;
+        size_t length;
+
+        benchBannerKey(i, name, sizeof name, &playerWins, &computerWins);
+        formatWinMessage(message, sizeof message, name, playerWins, computerWins);
+
+        char *banner = bannerRender(font, message, BENCH_BANNER_WIDTH, &length);
+
+        if (banner != NULL)
+            bannerCacheInsert(&bannerCache, name, playerWins, computerWins, BENCH_BANNER_WIDTH, banner, length);
+
+        free(banner);}
+
+    if (font != NULL) {
+        benchmarks[count++] = (Benchmark) {"banner_render", "banners/s", 1, benchBannerRender, font};
+        benchmarks[count++] = (Benchmark) {"banner_cache_hit", "banners/s", 1, benchBannerCache, &bannerCache};}
+
+    printf("{\n");
+    printf("  \"seed\": %d,\n", BENCH_SEED);
+    printf("  \"warmup\": %d,\n", options.warmup);
+    printf("  \"repetitions\": %d,\n", options.repetitions);
+    printf("  \"scale\": %g,\n", options.scale);
+    printf("  \"results\": [");
+
+    for (int i = 0; i < count; i++)
+        if (runBenchmark(&benchmarks[i], &options, i == 0) != 0)
+            return 1;
+
+    printf("\n  ]\n}\n");
+
+    outputSetDescriptor(STDOUT_FILENO);
+    close(devNull);
+
+    return 0;}
+
+int runBenchmark(const Benchmark *benchmark, const BenchOptions *options, int first) {
+
+    double *seconds = malloc((size_t) options->repetitions * sizeof *seconds);
+    long long work = 0;
+
+    if (seconds == NULL) {
+        perror("Sample allocation failed");
+        return 1;}
+
+    for (int i = 0; i < options->warmup + options->repetitions; i++) {
+
+        struct timespec start, end;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        work = benchmark->run(benchmark->context, options->scale);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (work < 0) {
+            fprintf(stderr, "Benchmark %s failed...\n", benchmark->name);
+            free(seconds);
+            return 1;}
+
+        if (i >= options->warmup)
+            seconds[i - options->warmup] = (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;}
+
+    qsort(seconds, (size_t) options->repetitions, sizeof *seconds, compareSeconds);
+
+    double median = percentile(seconds, options->repetitions, 50);
+    double p99 = percentile(seconds, options->repetitions, 99);
+
+    printf("%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"threads\": %d, \"work\": %lld, ", first ? "" : ",", benchmark->name, benchmark->unit, benchmark->threads, work);
+    printf("\"median\": %.0f, \"p99\": %.0f, \"min\": %.0f, \"max\": %.0f, ", work / median, work / p99, work / seconds[options->repetitions - 1], work / seconds[0]);
+    printf("\"median_seconds\": %.9f, \"p99_seconds\": %.9f}", median, p99);
+    fflush(stdout);
+
+    free(seconds);
+
+    return 0;}
+
+int parseBenchOptions(int argc, char *argv[], BenchOptions *options) {
+
+    options->warmup = BENCH_DEFAULT_WARMUP;
+    options->repetitions = BENCH_DEFAULT_REPETITIONS;
+    options->scale = 1.0;
+    options->threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (options->threads < 1)
+        options->threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;   // Argument following the option, if any
+        char *end;
+
+        if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+            printBenchUsage(stdout, argv[0]);
+            return -1;}
+
+        else if ((strcmp(argv[i], "--warmup") == 0) && (value != NULL)) {
+            long warmup = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (end == value) || (warmup < 0) || (warmup > BENCH_MAX_REPETITIONS)) {
+                fprintf(stderr, "--warmup expects an integer between 0 and %i...\n", BENCH_MAX_REPETITIONS);
+                return 1;}
+
+            options->warmup = (int) warmup;
+            i++;}
+
+        else if ((strcmp(argv[i], "--repetitions") == 0) && (value != NULL)) {
+            long repetitions = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (repetitions < 1) || (repetitions > BENCH_MAX_REPETITIONS)) {
+                fprintf(stderr, "--repetitions expects an integer between 1 and %i...\n", BENCH_MAX_REPETITIONS);
+                return 1;}
+
+            options->repetitions = (int) repetitions;
+            i++;}
+
+        else if ((strcmp(argv[i], "--scale") == 0) && (value != NULL)) {
+            options->scale = strtod(value, &end);
+
+            if ((*end != '\0') || (end == value) || !(options->scale > 0) || (options->scale > BENCH_MAX_SCALE)) {
+                fprintf(stderr, "--scale expects a positive number up to %i...\n", BENCH_MAX_SCALE);
+                return 1;}
+
+            i++;}
+
+        else if ((strcmp(argv[i], "--threads") == 0) && (value != NULL)) {
+            long threads = strtol(value, &end, 10);
+
+            if ((*end != '\0') || (threads < 1) || (threads > BENCH_MAX_THREADS)) {
+                fprintf(stderr, "--threads expects an integer between 1 and %i...\n", BENCH_MAX_THREADS);
+                return 1;}
+
+            options->threads = (int) threads;
+            i++;}
+
+        else {
+            fprintf(stderr, "Unknown or incomplete option: %s\n", argv[i]);
+            printBenchUsage(stderr, argv[0]);
+            return 1;}}
+
+    return 0;}
+
+void printBenchUsage(FILE *stream, const char *program) {
+
+    fprintf(stream, "Usage: %s [options]\n\n", program);
+    fprintf(stream, "Runs every benchmark and prints the results as JSON.\n\n");
+    fprintf(stream, "Options:\n");
+    fprintf(stream, "  --warmup N       Untimed repetitions before each benchmark (default %i)\n", BENCH_DEFAULT_WARMUP);
+    fprintf(stream, "  --repetitions N  Timed repetitions of each benchmark (default %i)\n", BENCH_DEFAULT_REPETITIONS);
+    fprintf(stream, "  --scale F        Multiply the work of every repetition by F (default 1)\n");
+    fprintf(stream, "  --threads T      Threads of the simulator benchmarks (default: one per CPU)\n");
+    fprintf(stream, "  -h, --help       Show this help and exit\n");}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-checkpoint.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Series state and its replay, and memory-mapped checkpoint
+ * files of series in progress.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <string.h>    // String manipulation functions (memset, memcmp, strncpy)
+# include <errno.h> // Error numbers (EINVAL) for files written by another build
+# include <unistd.h>    // POSIX operating system API (ftruncate, close)
+# include <fcntl.h> // POSIX file control (open)
+# include <sys/file.h>  // Advisory file locks (flock)
+# include <sys/mman.h>  // Memory mapping (mmap, msync, munmap)
+# include <sys/stat.h>  // File status (fstat)
+# include "sps-checkpoint.h"    // Checkpoint types and prototypes
+
+// Define constants for the file header
+#define CHECKPOINT_BYTE_ORDER 0x01020304u   // Reads back differently on a machine of the other byte order.
+
+// Data types
+/**
+ * @brief First page of a checkpoint file.
+ */
+typedef struct {
+    char magic[CHECKPOINT_MAGIC_LENGTH];    // CHECKPOINT_MAGIC
+    uint32_t byteOrder;                     // CHECKPOINT_BYTE_ORDER
+    uint32_t layout;                        // sizeof (SeriesState) of the build that created the file
+    uint32_t records;                       // Records after the header
+    _Atomic uint32_t used;                  // One more than the highest record ever claimed
+} CheckpointHeader;
+
+_Static_assert(offsetof(CheckpointRecord, series) + sizeof (SeriesState) <= CHECKPOINT_PAGE, "a series must fit in a checkpoint page");
+_Static_assert(sizeof (CheckpointRecord) == CHECKPOINT_PAGE, "records must be one page each");
+
+void seriesBegin(SeriesState *series, RngKind kind, uint64_t seed, const StrategySpec *spec, const char *name, int bestOf) {
+
+    memset(series, 0, sizeof *series);
+    series->seed = seed;
+    rngInit(&series->rng, kind, seed, 0);
+    strategyInit(&series->strategy, spec);
+    series->bestOf = bestOf;
+    series->winsNeeded = (bestOf + 1) / 2;
+    strncpy(series->playerName, name, MAX_PLAYER_NAME - 1);}
+
+int seriesPlayRound(SeriesState *series, int playerChoice, int *computerChoice) {
+
+    // The same steps, in the same order, as the game has always played a round.
+    *computerChoice = strategyChoose(&series->strategy, &series->rng);
+    strategyObserve(&series->strategy, playerChoice);
+
+    int outcome = resolveRound(playerChoice, *computerChoice);
+
+    series->playerWins += (outcome == ROUND_PLAYER_WINS);
+    series->computerWins += (outcome == ROUND_COMPUTER_WINS);
+
+    if (series->rounds < SERIES_LOG_ROUNDS)
+        series->moves[series->rounds / 4] |= (uint8_t) (playerChoice << (2 * (series->rounds % 4)));
+
+    series->rounds++;
+
+    return outcome;}
+
+int seriesOver(const SeriesState *series) {
+
+    return (series->playerWins >= series->winsNeeded) || (series->computerWins >= series->winsNeeded);}
+
+int seriesLoggedMove(const SeriesState *series, uint32_t round) {
+
+    return (series->moves[round / 4] >> (2 * (round % 4))) & 3;}
+
+int seriesReplay(const SeriesState *series, SeriesState *replayed) {
+
+    if (series->rounds > SERIES_LOG_ROUNDS)
+        return -1;
+
+    seriesBegin(replayed, series->rng.kind, series->seed, &series->strategy.spec, series->playerName, series->bestOf);
+
+    for (uint32_t round = 0; round < series->rounds; round++) {
+        int computerChoice;
+
+        seriesPlayRound(replayed, seriesLoggedMove(series, round), &computerChoice);}
+
+    return (memcmp(series, replayed, sizeof *series) == 0) ? 0 : 1;}
+
+int seriesVerify(SeriesState *series) {
+
+    SeriesState replayed;
+    int result = seriesReplay(series, &replayed);
+
+    if (result == 1)
+        *series = replayed;
+
+    return result;}
+
+/**
+ * @brief Returns the header page of a mapped file.
+ */
+static CheckpointHeader *checkpointHeader(const CheckpointFile *file) {
+
+    return (CheckpointHeader *) file->map;}
+
+int checkpointOpen(CheckpointFile *file, const char *path, uint32_t records) {
+
+    struct stat status;
+
+    file->descriptor = open(path, O_RDWR | O_CREAT, 0644);
+    file->map = NULL;
+
+    if (file->descriptor < 0)
+        return -1;
+
+    // A second process would play the same series: only one gets the lock.
+    if ((flock(file->descriptor, LOCK_EX | LOCK_NB) != 0) || (fstat(file->descriptor, &status) != 0))
+        goto failed;
+
+    int created = (status.st_size == 0);
+
+    // A new file is sparse: only the pages of records ever played take space.
+    if (created && (ftruncate(file->descriptor, (off_t) records * CHECKPOINT_PAGE + CHECKPOINT_PAGE) != 0))
+        goto failed;
+
+    file->length = created ? (size_t) records * CHECKPOINT_PAGE + CHECKPOINT_PAGE : (size_t) status.st_size;
+
+    if ((file->length < CHECKPOINT_PAGE) || (file->length % CHECKPOINT_PAGE != 0)) {
+        errno = EINVAL;
+        goto failed;}
+
+    file->map = mmap(NULL, file->length, PROT_READ | PROT_WRITE, MAP_SHARED, file->descriptor, 0);
+
+    if (file->map == MAP_FAILED) {
+        file->map = NULL;
+        goto failed;}
+
+    CheckpointHeader *header = checkpointHeader(file);
+
+    if (created) {
+        memcpy(header->magic, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_LENGTH);
+        header->byteOrder = CHECKPOINT_BYTE_ORDER;
+        header->layout = sizeof (SeriesState);
+        header->records = records;}
+
+    // Records are read as they are, so the file must come from a build with the same layout.
+    if ((memcmp(header->magic, CHECKPOINT_MAGIC, CHECKPOINT_MAGIC_LENGTH) != 0) || (header->byteOrder != CHECKPOINT_BYTE_ORDER)
+            || (header->layout != sizeof (SeriesState)) || ((size_t) header->records * CHECKPOINT_PAGE + CHECKPOINT_PAGE != file->length)) {
+        errno = EINVAL;
+        goto failed;}
+
+    // Records owned by a previous run are free to claim: no owner holds this token.
+    file->records = header->records;
+    file->run = rngEntropySeed() | 1;
+
+    return 0;
+
+failed:
+    if (file->map != NULL)
+        munmap(file->map, file->length);
+
+    int error = errno;
+
+    close(file->descriptor);
+    errno = error;
+
+    return -1;}
+
+void checkpointClose(CheckpointFile *file) {
+
+    msync(file->map, file->length, MS_SYNC);
+    munmap(file->map, file->length);
+    close(file->descriptor);}
+
+CheckpointRecord *checkpointRecord(const CheckpointFile *file, uint32_t index) {
+
+    return (CheckpointRecord *) (file->map + CHECKPOINT_PAGE + (size_t) index * CHECKPOINT_PAGE);}
+
+uint32_t checkpointUsed(const CheckpointFile *file) {
+
+    return atomic_load(&checkpointHeader(file)->used);}
+
+/**
+ * @brief Takes a record for this process if nobody plays it; returns non-zero on success.
+ */
+static int checkpointTake(const CheckpointFile *file, CheckpointRecord *record) {
+
+    uint64_t owner = atomic_load(&record->owner);
+
+    return (owner != file->run) && atomic_compare_exchange_strong(&record->owner, &owner, file->run);}
+
+uint32_t checkpointClaim(CheckpointFile *file, uint32_t *cursor, uint32_t first, uint32_t step) {
+
+    uint32_t count = (file->records > first) ? (file->records - first + step - 1) / step : 0;
+
+    for (uint32_t tried = 0; tried < count; tried++) {
+
+        uint32_t index = (*cursor < file->records) ? *cursor : first;
+        CheckpointRecord *record = checkpointRecord(file, index);
+
+        *cursor = index + step;
+
+        if (record->live || !checkpointTake(file, record))
+            continue;
+
+        // Nobody can resume a record that is not live, so it stays free once taken.
+        uint32_t used = atomic_load(&checkpointHeader(file)->used);
+
+        while ((used <= index) && !atomic_compare_exchange_weak(&checkpointHeader(file)->used, &used, index + 1))
+            ;
+
+        record->tag = (uint32_t) (rngEntropySeed() ^ index);
+        return index;}
+
+    return CHECKPOINT_NONE;}
+
+uint32_t checkpointResume(CheckpointFile *file, uint64_t code) {
+
+    uint32_t index = (uint32_t) (code >> 32);
+
+    if (index >= file->records)
+        return CHECKPOINT_NONE;
+
+    CheckpointRecord *record = checkpointRecord(file, index);
+
+    if (!record->live || (record->tag != (uint32_t) code) || !checkpointTake(file, record))
+        return CHECKPOINT_NONE;
+
+    // The series may have ended between the check and the claim.
+    if (!record->live || (record->tag != (uint32_t) code)) {
+        checkpointRelease(file, index);
+        return CHECKPOINT_NONE;}
+
+    return index;}
+
+uint64_t checkpointCode(const CheckpointFile *file, uint32_t index) {
+
+    return (uint64_t) index << 32 | checkpointRecord(file, index)->tag;}
+
+void checkpointRelease(CheckpointFile *file, uint32_t index) {
+
+    atomic_store(&checkpointRecord(file, index)->owner, 0);}
+
+void checkpointTouch(CheckpointBatch *batch, uint32_t index) {
+
+    if ((batch->first == CHECKPOINT_NONE) || (index < batch->first))
+        batch->first = index;
+
+    if ((batch->last == CHECKPOINT_NONE) || (index > batch->last))
+        batch->last = index;
+
+    batch->records++;}
+
+void checkpointSync(const CheckpointFile *file, CheckpointBatch *batch) {
+
+    if (batch->first == CHECKPOINT_NONE)
+        return;
+
+    // The pages are already in the page cache, safe from a crash of the process; this schedules them for the disk.
+    const uint8_t *start = (const uint8_t *) checkpointRecord(file, batch->first);
+
+    msync((void *) start, (size_t) (batch->last - batch->first + 1) * CHECKPOINT_PAGE, MS_ASYNC);
+    batch->syncs++;
+    batch->first = CHECKPOINT_NONE;
+    batch->last = CHECKPOINT_NONE;}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-checkpoint.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Resumable best-of series ('--checkpoint'). Everything a
+ * series depends on (its seed, random stream, counters, the computer's
+ * strategy tables and the player's moves) lives in one fixed-layout
+ * SeriesState, played only through seriesPlayRound, so the series can be
+ * replayed bit for bit from its seed and move log. A checkpoint file is a
+ * header page followed by one page per record, memory-mapped and shared:
+ * a round updates its record in place, and the pages dirtied by a batch
+ * of rounds are handed to the kernel with one msync.
+ *
+ * File layout (native byte order, checked against the header):
+ *
+ *   header             CHECKPOINT_PAGE bytes: CHECKPOINT_MAGIC, the layout
+ *                      check, the number of records and the highest one used
+ *   records            CHECKPOINT_PAGE bytes each, a CheckpointRecord
+ *
+ * A record is resumed with its code: its index in the high 32 bits, a
+ * random tag in the low 32 bits, printed as 16 hexadecimal digits.
+ */
+
+#ifndef SPS_CHECKPOINT_H
+#define SPS_CHECKPOINT_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint8_t, uint32_t, uint64_t)
+# include <stdatomic.h> // Atomic record owners shared by the server's event loops
+# include "sps-engine.h"    // Rng, Strategy and MAX_PLAYER_NAME
+
+// Define constants for the checkpoint file
+#define CHECKPOINT_MAGIC "SPSCKPT1" // First bytes of every checkpoint file.
+#define CHECKPOINT_MAGIC_LENGTH 8   // Length of CHECKPOINT_MAGIC.
+#define CHECKPOINT_PAGE 4096        // Size of the header and of every record: a round dirties one page.
+#define CHECKPOINT_NONE UINT32_MAX  // Index that refers to no record.
+#define SERIES_LOG_BYTES 1920       // Bytes of a series' move log.
+#define SERIES_LOG_ROUNDS (SERIES_LOG_BYTES * 4)    // Rounds the move log holds (2 bits each); longer series are resumed from their snapshot alone.
+#define CHECKPOINT_CODE_LENGTH 16   // Hexadecimal digits of a resume code.
+
+// Data types
+/**
+ * @brief A best-of series, from its seed to the last round played.
+ *
+ * Every field has a fixed size and the whole structure is zeroed before use,
+ * padding included, so two states of the same series compare equal with memcmp.
+ */
+typedef struct {
+    uint64_t seed;                      // Seed of the series' random stream (stream 0)
+    Rng rng;                            // The stream after the last round
+    Strategy strategy;                  // Computer's strategy and its model tables
+    int32_t bestOf;                     // 'Best-of' length
+    int32_t winsNeeded;                 // Wins required to win the series ('n' in main)
+    int32_t playerWins;                 // Rounds won by the player
+    int32_t computerWins;               // Rounds won by the computer
+    uint32_t rounds;                    // Rounds played, ties included
+    char playerName[MAX_PLAYER_NAME];   // Player's name
+    uint8_t moves[SERIES_LOG_BYTES];    // Player's choices, four per byte from the low bits up
+} SeriesState;
+
+/**
+ * @brief One page of a checkpoint file: a series and who may play it.
+ */
+typedef union {
+    struct {
+        _Atomic uint64_t owner; // Run token of the process playing the series (CheckpointFile.run), or anything else if nobody is
+        uint32_t live;          // Non-zero while the record holds a series that is not over
+        uint32_t tag;           // Random low half of the resume code, renewed with every series
+        SeriesState series;
+    };
+    uint8_t page[CHECKPOINT_PAGE];
+} CheckpointRecord;
+
+/**
+ * @brief Records dirtied since the last checkpointSync, as a span of indices.
+ */
+typedef struct {
+    uint32_t first;     // Lowest dirty record, or CHECKPOINT_NONE if none is
+    uint32_t last;      // Highest dirty record
+    long long syncs;    // msync calls made
+    long long records;  // Dirty records they covered
+} CheckpointBatch;
+
+/**
+ * @brief A checkpoint file mapped into memory.
+ */
+typedef struct {
+    int descriptor;             // Checkpoint file, locked for this process
+    uint8_t *map;               // Header page, then the records
+    size_t length;              // Bytes mapped
+    uint32_t records;           // Records in the file
+    uint64_t run;               // Token of this process: records it plays have it as their owner
+} CheckpointFile;
+
+// Function prototypes
+/**
+ * @brief Starts a series: a fresh random stream, strategy and zero scores.
+ *
+ * @param series State to initialise.
+ * @param kind Random number generator algorithm.
+ * @param seed Seed of the series' stream.
+ * @param spec Computer's strategy.
+ * @param name Player's name (truncated to MAX_PLAYER_NAME - 1 bytes).
+ * @param bestOf 'Best-of' length (a positive odd number).
+ */
+void seriesBegin(SeriesState *series, RngKind kind, uint64_t seed, const StrategySpec *spec, const char *name, int bestOf);
+
+/**
+ * @brief Plays one round: draws the computer's choice, updates the scores and the strategy, and logs the player's move.
+ *
+ * @param series State of the series.
+ * @param playerChoice Player's choice (1 to 3).
+ * @param computerChoice Set to the computer's choice (1 to 3).
+ * @return ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+int seriesPlayRound(SeriesState *series, int playerChoice, int *computerChoice);
+
+/**
+ * @brief Returns non-zero once either side has the wins needed.
+ */
+int seriesOver(const SeriesState *series);
+
+/**
+ * @brief Returns the player's choice in a round of the move log (0 to SERIES_LOG_ROUNDS - 1).
+ */
+int seriesLoggedMove(const SeriesState *series, uint32_t round);
+
+/**
+ * @brief Replays a series from its seed and move log.
+ *
+ * @param series State to replay.
+ * @param replayed Receives the state the replay arrives at.
+ * @return 0 if it is bit for bit the same as series, 1 if it differs, -1 if the move log does not hold every round.
+ */
+int seriesReplay(const SeriesState *series, SeriesState *replayed);
+
+/**
+ * @brief Checks a resumed series against its replay, and continues from the replay if the snapshot differs (a torn write).
+ *
+ * @param series State to check; replaced by the replayed state if they differ.
+ * @return The result of seriesReplay.
+ */
+int seriesVerify(SeriesState *series);
+
+/**
+ * @brief Opens a checkpoint file, creating it with the given number of records if needed, and maps it.
+ *
+ * The file is locked, so that one process at a time plays its series. An
+ * existing file keeps its own number of records.
+ *
+ * @param file Pointer to the structure to fill in.
+ * @param path Checkpoint file.
+ * @param records Records of a new file.
+ * @return 0 on success, -1 if the file could not be opened, locked, mapped or was written by a different build (errno tells).
+ */
+int checkpointOpen(CheckpointFile *file, const char *path, uint32_t records);
+
+/**
+ * @brief Writes every dirty page out, waiting for the disk, and unmaps the file.
+ */
+void checkpointClose(CheckpointFile *file);
+
+/**
+ * @brief Returns a record by index.
+ */
+CheckpointRecord *checkpointRecord(const CheckpointFile *file, uint32_t index);
+
+/**
+ * @brief Number of records ever claimed (the records below it may hold series).
+ */
+uint32_t checkpointUsed(const CheckpointFile *file);
+
+/**
+ * @brief Claims a record without a series in progress, searching the records first, first + step, ...
+ *
+ * @param file Pointer to the file.
+ * @param cursor Where the previous search stopped (a multiple of step plus first); updated.
+ * @param first First index of the records searched.
+ * @param step Distance between the records searched (the event loops split the file this way).
+ * @return Index of the claimed record, or CHECKPOINT_NONE if every one searched is taken.
+ */
+uint32_t checkpointClaim(CheckpointFile *file, uint32_t *cursor, uint32_t first, uint32_t step);
+
+/**
+ * @brief Claims the record of a series in progress that nobody is playing.
+ *
+ * @param file Pointer to the file.
+ * @param code Resume code of the series.
+ * @return Index of the claimed record, or CHECKPOINT_NONE if the code is unknown, finished or already being played.
+ */
+uint32_t checkpointResume(CheckpointFile *file, uint64_t code);
+
+/**
+ * @brief Returns the resume code of a record.
+ */
+uint64_t checkpointCode(const CheckpointFile *file, uint32_t index);
+
+/**
+ * @brief Gives a record up: its series, if not over, can be resumed by whoever has its code.
+ */
+void checkpointRelease(CheckpointFile *file, uint32_t index);
+
+/**
+ * @brief Adds a record to the batch of dirty records.
+ */
+void checkpointTouch(CheckpointBatch *batch, uint32_t index);
+
+/**
+ * @brief Hands the batch's dirty pages to the kernel for writing with one msync (MS_ASYNC), then empties the batch.
+ */
+void checkpointSync(const CheckpointFile *file, CheckpointBatch *batch);
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-deflate.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Minimal deflate encoder: greedy LZ77 matching over hash
+ * chains, coded with the fixed Huffman codes of RFC 1951.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <string.h>    // String manipulation functions (memset, memcpy)
+# include "sps-deflate.h"   // Deflate constants and prototypes
+
+// Define constants for the matcher
+#define DEFLATE_WINDOW 32768    // Farthest back a match may start.
+#define DEFLATE_HASH_BITS 12    // log2 of the number of hash chains.
+#define DEFLATE_MIN_MATCH 3     // Shortest match worth coding.
+#define DEFLATE_MAX_MATCH 258   // Longest match deflate can code.
+#define DEFLATE_MAX_CHAIN 64    // Earlier positions tried per match.
+
+// Data types
+/**
+ * @brief Bits written least significant first, as deflate packs them.
+ */
+typedef struct {
+    uint8_t *output;    // Next byte to write
+    uint64_t bits;      // Bits not written yet, from bit 0
+    int count;          // Number of such bits
+} BitWriter;
+
+/**
+ * @brief Hash chains of the positions seen so far.
+ */
+typedef struct {
+    int32_t head[1 << DEFLATE_HASH_BITS];   // Latest position of each hash, or -1
+    int32_t previous[DEFLATE_WINDOW];       // Position before each one (modulo the window) with the same hash
+} DeflateMatcher;
+
+// Base values and extra bits of the length codes 257 to 285, then of the distance codes 0 to 29.
+static const uint16_t lengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t lengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t distanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t distanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+// Per thread: the tables are too large to want on the stack, and every server loop compresses banners.
+static _Thread_local DeflateMatcher matcher;
+
+/**
+ * @brief Appends count bits of value.
+ */
+static void bitsPut(BitWriter *writer, uint32_t value, int count) {
+
+    writer->bits |= (uint64_t) value << writer->count;
+    writer->count += count;
+
+    while (writer->count >= 8) {
+        *writer->output++ = (uint8_t) writer->bits;
+        writer->bits >>= 8;
+        writer->count -= 8;}}
+
+/**
+ * @brief Appends a Huffman code, which deflate packs most significant bit first.
+ */
+static void bitsPutCode(BitWriter *writer, uint32_t code, int count) {
+
+    uint32_t reversed = 0;
+
+    for (int i = 0; i < count; i++)
+        reversed |= ((code >> i) & 1) << (count - 1 - i);
+
+    bitsPut(writer, reversed, count);}
+
+/**
+ * @brief Appends a literal/length symbol (0 to 285) in the fixed code.
+ */
+static void putSymbol(BitWriter *writer, int symbol) {
+
+    if (symbol < 144)
+        bitsPutCode(writer, 0x30 + (uint32_t) symbol, 8);
+
+    else if (symbol < 256)
+        bitsPutCode(writer, 0x190 + (uint32_t) (symbol - 144), 9);
+
+    else if (symbol < 280)
+        bitsPutCode(writer, (uint32_t) (symbol - 256), 7);
+
+    else
+        bitsPutCode(writer, 0xc0 + (uint32_t) (symbol - 280), 8);}
+
+/**
+ * @brief Appends a match of length bytes starting distance bytes back.
+ */
+static void putMatch(BitWriter *writer, int length, int distance) {
+
+    int code = 28;
+
+    while (lengthBase[code] > length)
+        code--;
+
+    // 258 has a code of its own, without extra bits.
+    putSymbol(writer, 257 + code);
+    bitsPut(writer, (uint32_t) (length - lengthBase[code]), lengthExtra[code]);
+
+    code = 29;
+
+    while (distanceBase[code] > distance)
+        code--;
+
+    bitsPutCode(writer, (uint32_t) code, 5);
+    bitsPut(writer, (uint32_t) (distance - distanceBase[code]), distanceExtra[code]);}
+
+/**
+ * @brief Returns the hash chain of the three bytes at data.
+ */
+static uint32_t matchHash(const uint8_t *data) {
+
+    uint32_t key = (uint32_t) data[0] << 16 | (uint32_t) data[1] << 8 | data[2];
+
+    return (key * 2654435761u) >> (32 - DEFLATE_HASH_BITS);}
+
+/**
+ * @brief Adds the position to its hash chain.
+ */
+static void matchInsert(const uint8_t *data, int32_t position) {
+
+    uint32_t hash = matchHash(data + position);
+
+    matcher.previous[position & (DEFLATE_WINDOW - 1)] = matcher.head[hash];
+    matcher.head[hash] = position;}
+
+/**
+ * @brief Finds the longest earlier match of the bytes at position; returns its length (0 if under DEFLATE_MIN_MATCH).
+ */
+static int matchFind(const uint8_t *data, int32_t length, int32_t position, int *distance) {
+
+    int limit = (length - position < DEFLATE_MAX_MATCH) ? length - position : DEFLATE_MAX_MATCH;
+    int best = 0;
+    int32_t candidate = matcher.head[matchHash(data + position)];
+
+    // Positions only ever decrease along a chain; one that does not was overwritten by a later position.
+    for (int tries = 0; (tries < DEFLATE_MAX_CHAIN) && (candidate >= 0) && (position - candidate <= DEFLATE_WINDOW); tries++) {
+
+        int matched = 0;
+
+        // A match may overlap the bytes it produces: the decoder copies them one at a time.
+        while ((matched < limit) && (data[candidate + matched] == data[position + matched]))
+            matched++;
+
+        if (matched > best) {
+            best = matched;
+            *distance = position - candidate;
+
+            if (best == limit)
+                break;}
+
+        int32_t next = matcher.previous[candidate & (DEFLATE_WINDOW - 1)];
+
+        if (next >= candidate)
+            break;
+
+        candidate = next;}
+
+    return (best >= DEFLATE_MIN_MATCH) ? best : 0;}
+
+size_t deflateCompress(const void *data, size_t length, uint8_t *output) {
+
+    const uint8_t *bytes = data;
+    int32_t size = (int32_t) length;
+    BitWriter writer = {output, 0, 0};
+
+    memset(matcher.head, 0xff, sizeof matcher.head);
+
+    // One non-final block with the fixed codes.
+    bitsPut(&writer, 0, 1);
+    bitsPut(&writer, 1, 2);
+
+    for (int32_t position = 0; position < size; ) {
+
+        int distance = 0;
+        int matched = (position + DEFLATE_MIN_MATCH <= size) ? matchFind(bytes, size, position, &distance) : 0;
+
+        if (matched == 0) {
+            putSymbol(&writer, bytes[position]);
+            matched = 1;}
+
+        else
+            putMatch(&writer, matched, distance);
+
+        // Every position a later match could start from joins its chain, matched over or not.
+        for (int32_t end = position + matched; position < end; position++)
+            if (position + DEFLATE_MIN_MATCH <= size)
+                matchInsert(bytes, position);}
+
+    putSymbol(&writer, 256);    // End of block
+
+    // The empty stored block of a sync flush: its header, padding to the byte, then LEN and NLEN.
+    bitsPut(&writer, 0, 3);
+    bitsPut(&writer, 0, (8 - writer.count) & 7);
+    memcpy(writer.output, DEFLATE_SYNC_MARKER, DEFLATE_SYNC_MARKER_LENGTH);
+
+    return (size_t) (writer.output - output) + DEFLATE_SYNC_MARKER_LENGTH;}
+
+void deflateStoredHeader(uint8_t header[DEFLATE_STORED_HEADER], size_t length) {
+
+    // BFINAL 0 and BTYPE 00, padded to the byte: blocks before it always end byte-aligned.
+    header[0] = 0;
+    header[1] = (uint8_t) length;
+    header[2] = (uint8_t) (length >> 8);
+    header[3] = (uint8_t) ~length;
+    header[4] = (uint8_t) (~length >> 8);}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-deflate.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Minimal deflate (RFC 1951) encoder for output that is
+ * compressed once and sent many times: the server's round frames and result
+ * banners. Every call produces self-contained blocks that end on a byte
+ * boundary, so compressed pieces can be spliced into one stream in any order.
+ */
+
+#ifndef SPS_DEFLATE_H
+#define SPS_DEFLATE_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint8_t)
+
+// Define constants for the deflate encoder
+#define DEFLATE_BOUND(length) ((length) + (length) / 8 + 16)    // Output bytes deflateCompress may need for length input bytes.
+#define DEFLATE_STORED_HEADER 5     // Bytes before the data of a stored (uncompressed) block.
+#define DEFLATE_STORED_MAX 65535    // Data bytes one stored block can hold.
+#define DEFLATE_SYNC_MARKER "\x00\x00\xff\xff"  // Last bytes of every deflateCompress output (an empty stored block).
+#define DEFLATE_SYNC_MARKER_LENGTH 4    // Length of DEFLATE_SYNC_MARKER.
+#define DEFLATE_ZLIB_HEADER "\x78\x01"  // zlib (RFC 1950) header of a stream of such blocks: 32 KiB window, no dictionary.
+#define DEFLATE_ZLIB_HEADER_LENGTH 2    // Length of DEFLATE_ZLIB_HEADER.
+
+// Function prototypes
+/**
+ * @brief Compresses bytes into non-final deflate blocks that reference nothing before them.
+ *
+ * The data is matched with a hash-chained LZ77 search over itself only and
+ * coded with the fixed Huffman codes (runs of padding become a few bytes
+ * each), then followed by an empty stored block, as zlib's Z_SYNC_FLUSH
+ * does, so the output ends byte-aligned and a decoder can emit everything
+ * at once. Any sequence of such outputs and deflateStoredHeader blocks is a
+ * valid deflate stream.
+ *
+ * @param data Bytes to compress.
+ * @param length Number of bytes (at most 2^31 - 1).
+ * @param output Buffer of at least DEFLATE_BOUND(length) bytes.
+ * @return Number of bytes written to output.
+ */
+size_t deflateCompress(const void *data, size_t length, uint8_t *output);
+
+/**
+ * @brief Writes the header of a non-final stored block, after which length bytes are copied as they are.
+ *
+ * @param header Buffer of DEFLATE_STORED_HEADER bytes.
+ * @param length Bytes the block will hold (at most DEFLATE_STORED_MAX).
+ */
+void deflateStoredHeader(uint8_t header[DEFLATE_STORED_HEADER], size_t length);
+
+#endif
@@ -0,0 +1,1151 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-engine.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Round resolution, random number generators and the headless
+ * simulator.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (fprintf, perror, snprintf)
+# include <stdlib.h>    // Standard library functions (aligned_alloc, free)
+# include <string.h>    // String manipulation functions (memset, memcpy, memchr, strcmp, strncmp)
+# include <time.h>  // Time functions (clock_gettime) for timing and seeding the random number generator
+# include <unistd.h>    // POSIX operating system API (getpid)
+# include <pthread.h>   // POSIX threads (pthread_create, pthread_join) for parallel simulations
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# include <immintrin.h> // SSE2 and AVX2 intrinsics for the batch kernels
+#elif defined(__aarch64__)
+# include <arm_neon.h>  // NEON intrinsics for the batch kernel
+#endif
+# include "sps-engine.h"    // Engine types and prototypes
+
+// Define constants for the simulator
+#define CACHE_LINE_SIZE 64   // Alignment used to keep per-thread counters on separate cache lines.
+
+// Data types
+/**
+ * @brief Work item and private state of one simulation thread.
+ *
+ * Each worker is aligned to (and padded to a multiple of) a cache line, so
+ * the counters updated by different threads never share a line. Workers
+ * only touch their own structure; the counters are combined once all
+ * threads have been joined.
+ */
+typedef struct {
+    _Alignas(CACHE_LINE_SIZE) SimulationResult result; // Counters of this worker only
+    Rng rng;                                // Private random number stream
+    long long series;                       // Number of series this worker plays
+    int bestOf;                             // 'Best-of' length of every series
+    int (*resolver)(int, int);              // Round resolver to use
+    StrategySpec playerStrategy;            // Strategy of the player
+    StrategySpec computerStrategy;          // Strategy of the computer
+    const Variant *variant;                 // Variant played, or NULL for the classic game
+    long long rounds;                       // Number of independent rounds this worker plays with the batch kernel
+    const BatchKernel *kernel;              // Batch kernel to use, or NULL to play series
+    BatchRng batchRng;                      // Private lanes of the batch kernel
+    pthread_t thread;                       // Thread running the worker
+} SimulationWorker;
+
+// Default stream of the calling thread, used by randomNumber().
+static _Thread_local Rng defaultRng;
+
+int randomNumber(int min, int max) {
+
+    int number;
+
+    number = (int) rngBounded(&defaultRng, (uint32_t) (max - min + 1)) + min;
+
+    return number;}
+
+/**
+ * @brief SplitMix64 step, used to expand a single seed into a full generator state.
+ */
+static uint64_t splitMix64(uint64_t *x) {
+
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);}
+
+static inline uint64_t rotateLeft64(uint64_t x, int k) {
+
+    return (x << k) | (x >> (64 - k));}
+
+/**
+ * @brief Advances a xoshiro256** state and returns the next 64-bit output.
+ */
+static inline uint64_t xoshiroNext(uint64_t *s) {
+
+    uint64_t result = rotateLeft64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotateLeft64(s[3], 45);
+
+    return result;}
+
+/**
+ * @brief Advances a xoshiro256** state by 2^128 draws, giving a non-overlapping stream.
+ */
+static void xoshiroJump(uint64_t *s) {
+
+    static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t t[4] = {0};
+
+    for (int i = 0; i < 4; i++)
+        for (int b = 0; b < 64; b++) {
+
+            if (jump[i] & (1ULL << b))
+                for (int w = 0; w < 4; w++)
+                    t[w] ^= s[w];
+
+            xoshiroNext(s);}
+
+    memcpy(s, t, sizeof t);}
+
+void rngInit(Rng *rng, RngKind kind, uint64_t seed, unsigned stream) {
+
+    uint64_t x = seed;
+
+    rng->kind = kind;
+
+    if (kind == RNG_PCG32) {
+        // The stream index selects the (odd) increment, then the state is warmed up once.
+        uint64_t mix = splitMix64(&x);
+        rng->state[1] = ((splitMix64(&x) ^ ((uint64_t) stream * 0x9e3779b97f4a7c15ULL)) << 1) | 1u;
+        rng->state[0] = 0;
+        rngNext32(rng);
+        rng->state[0] += mix;
+        rngNext32(rng);}
+
+    else {
+        for (int i = 0; i < 4; i++)
+            rng->state[i] = splitMix64(&x);
+
+        for (unsigned i = 0; i < stream; i++)
+            xoshiroJump(rng->state);}}
+
+uint32_t rngNext32(Rng *rng) {
+
+    if (rng->kind == RNG_PCG32) {
+        uint64_t old = rng->state[0];
+        rng->state[0] = old * 6364136223846793005ULL + rng->state[1];
+
+        uint32_t xorShifted = (uint32_t) (((old >> 18) ^ old) >> 27);
+        uint32_t rotation = (uint32_t) (old >> 59);
+
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));}
+
+    return (uint32_t) (xoshiroNext(rng->state) >> 32);}    // The upper bits are the strongest
+
+uint32_t rngBounded(Rng *rng, uint32_t range) {
+
+    uint64_t product = (uint64_t) rngNext32(rng) * range;
+    uint32_t low = (uint32_t) product;
+
+    // Only draws whose low half falls below (2^32 mod range) are biased; reject those.
+    if (low < range) {
+        uint32_t threshold = -range % range;
+
+        while (low < threshold) {
+            product = (uint64_t) rngNext32(rng) * range;
+            low = (uint32_t) product;}}
+
+    return (uint32_t) (product >> 32);}
+
+Rng *rngDefault(void) {
+
+    return &defaultRng;}
+
+void rngSeedDefault(RngKind kind, uint64_t seed) {
+
+    rngInit(&defaultRng, kind, seed, 0);}
+
+uint64_t rngEntropySeed(void) {
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    uint64_t x = ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec) ^ ((uint64_t) getpid() << 32);
+
+    return splitMix64(&x);}
+
+int parseChoice(const char *input, size_t length) {
+
+    if (length == 0)
+        return 0;
+
+    const char *name;
+    int choice;
+
+    // OR-ing 0x20 lowercases a letter, and only a letter of either case becomes a lowercase one.
+    switch ((length << 8) | (unsigned char) (input[0] | 0x20)) {
+        case (5 << 8) | 's': name = "stone"; choice = 1; break;
+        case (5 << 8) | 'p': name = "paper"; choice = 2; break;
+        case (8 << 8) | 's': name = "scissors"; choice = 3; break;
+        default: return 0;}
+
+    for (size_t i = 1; i < length; i++)
+        if ((input[i] | 0x20) != name[i])
+            return 0;
+
+    return choice;}
+
+void choiceTokenizerInit(ChoiceTokenizer *tokenizer) {
+
+    tokenizer->variant = VARIANT_CLASSIC;
+    tokenizer->length = 0;
+    tokenizer->attempts = 0;}
+
+size_t choiceTokenizerFeed(ChoiceTokenizer *tokenizer, const char *data, size_t length, int *result) {
+
+    const char *newline = memchr(data, '\n', length);
+    size_t lineLength = (newline != NULL) ? (size_t) (newline - data) : length;
+    size_t limit = (tokenizer->variant == VARIANT_CLASSIC) ? MAX_CHOICE_INPUT_LENGTH - 1 : sizeof tokenizer->token;
+    size_t room = limit - tokenizer->length;
+    size_t kept = (lineLength < room) ? lineLength : room;
+
+    memcpy(tokenizer->token + tokenizer->length, data, kept);
+    tokenizer->length += (uint8_t) kept;
+
+    if (newline == NULL) {
+        *result = CHOICE_PENDING;
+        return length;}
+
+    *result = choiceTokenizerEndLine(tokenizer);
+
+    return lineLength + 1;}
+
+int choiceTokenizerEndLine(ChoiceTokenizer *tokenizer) {
+
+    size_t length = tokenizer->length;
+
+    if ((length > 0) && (tokenizer->token[length - 1] == '\r'))    // Telnet-style line ending
+        length--;
+
+    int choice = (tokenizer->variant == VARIANT_CLASSIC) ? parseChoice(tokenizer->token, length) : variantParseMove(variantGet((VariantId) tokenizer->variant), tokenizer->token, length);
+
+    tokenizer->length = 0;
+
+    if (choice != 0) {
+        tokenizer->attempts = 0;
+        return choice;}
+
+    if (++tokenizer->attempts < MAX_CHOICE_ATTEMPTS)
+        return CHOICE_INVALID;
+
+    tokenizer->attempts = 0;
+
+    return CHOICE_EXHAUSTED;}
+
+void formatWinMessage(char *buffer, size_t size, const char *playerName, int playerWins, int computerWins) {
+
+    if (playerWins > computerWins)
+        snprintf(buffer, size, "%s  :  %i        |        Computer  :  %i\n%s   wins !", playerName, playerWins, computerWins, playerName);
+    else
+        snprintf(buffer, size, "%s  :  %i        |        Computer  :  %i\nComputer   wins !", playerName, playerWins, computerWins);}
+
+int resolveRound(int playerChoice, int computerChoice) {
+
+    // Outcome of every (player, computer) pair, indexed by (choice - 1).
+    // Each entry equals (playerChoice - computerChoice + 3) % 3.
+    static const int roundOutcomes[3][3] = {
+        // Stone              Paper                Scissors            <- computer
+        {ROUND_TIE,           ROUND_COMPUTER_WINS, ROUND_PLAYER_WINS},     // Stone
+        {ROUND_PLAYER_WINS,   ROUND_TIE,           ROUND_COMPUTER_WINS},   // Paper
+        {ROUND_COMPUTER_WINS, ROUND_PLAYER_WINS,   ROUND_TIE}};            // Scissors
+
+    return roundOutcomes[playerChoice - 1][computerChoice - 1];}
+
+int resolveRoundBranchy(int playerChoice, int computerChoice) {
+
+    if (playerChoice == 1) {    // Player chose Stone
+
+        if (computerChoice == 1)    // Stone vs Stone = Tie
+            return ROUND_TIE;
+
+        else if (computerChoice == 2)   // Stone vs Paper = Computer Wins
+            return ROUND_COMPUTER_WINS;
+
+        else    // Stone vs Scissors = Player Wins
+            return ROUND_PLAYER_WINS;}
+
+    else if (playerChoice == 2) {   // Player chose Paper
+
+        if (computerChoice == 1)    // Paper vs Stone = Player Wins
+            return ROUND_PLAYER_WINS;
+
+        else if (computerChoice == 2)   // Paper vs Paper = Tie
+            return ROUND_TIE;
+
+        else    // Paper vs Scissors = Computer Wins
+            return ROUND_COMPUTER_WINS;}
+
+    else {  // Player chose Scissors
+
+        if (computerChoice == 1)    // Scissors vs Stone = Computer Wins
+            return ROUND_COMPUTER_WINS;
+
+        else if (computerChoice == 2)   // Scissors vs Paper = Player Wins
+            return ROUND_PLAYER_WINS;
+
+        else    // Scissors vs Scissors = Tie
+            return ROUND_TIE;}}
+
+// Move names of every variant, indexed by (move - 1).
+static const char *const classicMoves[] = {"Stone", "Paper", "Scissors"};
+static const char *const rpslsMoves[] = {"Stone", "Paper", "Scissors", "Spock", "Lizard"};
+static const char *const rps101Moves[] = {
+    "Dynamite", "Tornado", "Quicksand", "Pit", "Chain", "Gun", "Law", "Whip", "Sword", "Rock",
+    "Death", "Wall", "Sun", "Camera", "Fire", "Chainsaw", "School", "Scissors", "Poison", "Cage",
+    "Axe", "Peace", "Computer", "Castle", "Snake", "Blood", "Porcupine", "Vulture", "Monkey", "King",
+    "Queen", "Prince", "Princess", "Police", "Woman", "Baby", "Man", "Home", "Train", "Car",
+    "Noise", "Bicycle", "Tree", "Turnip", "Duck", "Wolf", "Cat", "Bird", "Fish", "Spider",
+    "Cockroach", "Brain", "Community", "Cross", "Money", "Vampire", "Sponge", "Church", "Butter", "Book",
+    "Paper", "Cloud", "Airplane", "Moon", "Grass", "Film", "Toilet", "Air", "Planet", "Guitar",
+    "Bowl", "Cup", "Beer", "Rain", "Water", "TV", "Rainbow", "UFO", "Alien", "Prayer",
+    "Mountain", "Satan", "Dragon", "Diamond", "Platinum", "Gold", "Devil", "Fence", "Video Game", "Math",
+    "Robot", "Heart", "Electricity", "Lightning", "Medusa", "Power", "Laser", "Nuke", "Sky", "Tank",
+    "Helicopter"};
+
+// Every variant, indexed by VariantId; the matrices and hashes are filled in by variantBuildAll.
+static Variant variants[VARIANT_COUNT] = {
+    {.id = VARIANT_CLASSIC, .name = "rps", .moves = 3, .rule = VARIANT_RULE_PARITY, .moveNames = classicMoves},
+    {.id = VARIANT_RPSLS, .name = "rpsls", .moves = 5, .rule = VARIANT_RULE_PARITY, .moveNames = rpslsMoves},
+    {.id = VARIANT_RPS101, .name = "rps101", .moves = 101, .rule = VARIANT_RULE_FOLLOWING, .moveNames = rps101Moves}};
+
+static pthread_once_t variantsBuilt = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Lowercases an ASCII letter; other bytes are returned unchanged.
+ */
+static inline unsigned char variantLower(unsigned char c) {
+
+    return ((c >= 'A') && (c <= 'Z')) ? (unsigned char) (c | 0x20) : c;}
+
+/**
+ * @brief Case-insensitive FNV-1a hash of a move name, varied by a seed.
+ */
+static uint32_t variantHash(const char *text, size_t length, uint32_t seed) {
+
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= variantLower((unsigned char) text[i]);
+        hash *= 16777619u;}
+
+    return hash ^ (hash >> 15);}
+
+/**
+ * @brief Builds the perfect hash of a variant's move names.
+ *
+ * Names are split into buckets by a first hash; the largest buckets are
+ * placed first, each with the first displacement (seed of a second hash)
+ * that sends all its names to free slots.
+ */
+static void variantBuildHash(Variant *variant) {
+
+    uint8_t bucketMoves[VARIANT_HASH_BUCKETS][VARIANT_MAX_MOVES];
+    int bucketSizes[VARIANT_HASH_BUCKETS] = {0};
+
+    for (int m = 0; m < variant->moves; m++) {
+        const char *name = variant->moveNames[m];
+        uint32_t bucket = variantHash(name, strlen(name), 0) & (VARIANT_HASH_BUCKETS - 1);
+
+        bucketMoves[bucket][bucketSizes[bucket]++] = (uint8_t) (m + 1);}
+
+    for (int size = variant->moves; size > 0; size--)
+        for (int bucket = 0; bucket < VARIANT_HASH_BUCKETS; bucket++) {
+
+            if (bucketSizes[bucket] != size)
+                continue;
+
+            for (uint32_t displacement = 1; displacement <= UINT16_MAX; displacement++) {
+
+                uint32_t slots[VARIANT_MAX_MOVES];
+                int placed = 0;
+
+                // Every name of the bucket needs a free slot, distinct from the others'.
+                for (; placed < size; placed++) {
+                    const char *name = variant->moveNames[bucketMoves[bucket][placed] - 1];
+                    uint32_t slot = variantHash(name, strlen(name), displacement) & (VARIANT_HASH_SLOTS - 1);
+                    int taken = (variant->slots[slot] != 0);
+
+                    for (int k = 0; k < placed; k++)
+                        taken |= (slots[k] == slot);
+
+                    if (taken)
+                        break;
+
+                    slots[placed] = slot;}
+
+                if (placed < size)
+                    continue;
+
+                for (int k = 0; k < size; k++)
+                    variant->slots[slots[k]] = bucketMoves[bucket][k];
+
+                variant->displacements[bucket] = (uint16_t) displacement;
+                break;}}}
+
+/**
+ * @brief Fills in the outcome matrix and the name hash of every variant.
+ */
+static void variantBuildAll(void) {
+
+    for (int v = 0; v < VARIANT_COUNT; v++) {
+
+        Variant *variant = &variants[v];
+        int n = variant->moves;
+
+        for (int a = 0; a < n; a++)
+            for (int b = 0; b < n; b++) {
+
+                int ahead = ((b - a) % n + n) % n;  // Steps from a forward to b
+                int beats = (variant->rule == VARIANT_RULE_PARITY) ? (((a - b) % n + n) % n) % 2 : (ahead >= 1) && (ahead <= (n - 1) / 2);
+
+                if (beats)
+                    variant->beats[a][b >> 6] |= UINT64_C(1) << (b & 63);}
+
+        variantBuildHash(variant);}}
+
+const Variant *variantFind(const char *name) {
+
+    pthread_once(&variantsBuilt, variantBuildAll);
+
+    for (int v = 0; v < VARIANT_COUNT; v++)
+        if (strcmp(variants[v].name, name) == 0)
+            return &variants[v];
+
+    return NULL;}
+
+const Variant *variantGet(VariantId id) {
+
+    pthread_once(&variantsBuilt, variantBuildAll);
+
+    return &variants[id];}
+
+int variantParseMove(const Variant *variant, const char *input, size_t length) {
+
+    if ((length == 0) || (length >= VARIANT_MAX_NAME))
+        return 0;
+
+    uint32_t bucket = variantHash(input, length, 0) & (VARIANT_HASH_BUCKETS - 1);
+    int move = variant->slots[variantHash(input, length, variant->displacements[bucket]) & (VARIANT_HASH_SLOTS - 1)];
+
+    if (move == 0)
+        return 0;
+
+    // The slot holds the only candidate; confirm it is the name typed.
+    const char *name = variant->moveNames[move - 1];
+
+    for (size_t i = 0; i < length; i++)
+        if (variantLower((unsigned char) input[i]) != variantLower((unsigned char) name[i]))
+            return 0;
+
+    return (name[length] == '\0') ? move : 0;}
+
+int variantResolve(const Variant *variant, int playerChoice, int computerChoice) {
+
+    int c = computerChoice - 1;
+    int playerBeats = (int) ((variant->beats[playerChoice - 1][c >> 6] >> (c & 63)) & 1);
+
+    // 2 - 1 if the player's move beats the computer's, 2 - 0 if it loses, 0 - 0 on a tie.
+    return ((playerChoice != computerChoice) << 1) - playerBeats;}
+
+void variantFormatMoves(const Variant *variant, char *buffer, size_t size) {
+
+    size_t used = 0;
+
+    buffer[0] = '\0';
+
+    for (int m = 0; (m < variant->moves) && (used < size); m++) {
+        const char *separator = (m == 0) ? "" : (m == variant->moves - 1) ? " or " : ", ";
+        int written = snprintf(buffer + used, size - used, "%s%s", separator, variant->moveNames[m]);
+
+        used += (written > 0) ? (size_t) written : 0;}}
+
+// Powers of three: the number of histories of each Markov order.
+static const uint32_t strategyContexts[STRATEGY_MAX_ORDER + 1] = {1, 3, 9, 27, 81};
+
+int strategyParse(const char *name, StrategySpec *spec) {
+
+    static const char *names[] = {"random", "frequency", "markov", "ensemble", "cycle"};
+
+    spec->order = STRATEGY_DEFAULT_ORDER;
+
+    for (int i = 0; i < 5; i++)
+        if (strcmp(name, names[i]) == 0) {
+            spec->kind = (StrategyKind) i;
+            return 0;}
+
+    // "markovK" picks the order.
+    if ((strncmp(name, "markov", 6) == 0) && (name[6] >= '1') && (name[6] <= '0' + STRATEGY_MAX_ORDER) && (name[7] == '\0')) {
+        spec->kind = STRATEGY_MARKOV;
+        spec->order = name[6] - '0';
+        return 0;}
+
+    return -1;}
+
+void strategyFormat(const StrategySpec *spec, char *buffer, size_t size) {
+
+    static const char *names[] = {"random", "frequency", "markov", "ensemble", "cycle"};
+
+    if (spec->kind == STRATEGY_MARKOV)
+        snprintf(buffer, size, "markov%i", spec->order);
+    else
+        snprintf(buffer, size, "%s", names[spec->kind]);}
+
+void strategyInit(Strategy *strategy, const StrategySpec *spec) {
+
+    memset(strategy, 0, sizeof *strategy);
+    strategy->spec = *spec;}
+
+/**
+ * @brief Returns the move that beats a move.
+ */
+static int strategyCounter(int move) {
+
+    return move % 3 + 1;}
+
+/**
+ * @brief Returns the most frequent move of a row of counts (ties broken at random), or 0 if the row is empty.
+ */
+static int strategyPredict(const uint16_t counts[3], Rng *rng) {
+
+    int best = 0;
+    uint32_t ties = 0;
+    uint16_t highest = 0;
+
+    for (int i = 0; i < 3; i++) {
+
+        if (counts[i] > highest) {
+            highest = counts[i];
+            best = i + 1;
+            ties = 1;}
+
+        // Each tied move replaces the pick with probability 1 / ties, so all are equally likely.
+        else if ((counts[i] == highest) && (highest > 0) && (rngBounded(rng, ++ties) == 0))
+            best = i + 1;}
+
+    return best;}
+
+/**
+ * @brief Returns the row of Markov counts following the last 'order' opponent moves.
+ */
+static uint16_t *strategyMarkovRow(Strategy *strategy, int order) {
+
+    return strategy->markov[order - 1][strategy->history % strategyContexts[order]];}
+
+/**
+ * @brief Counts a move in a row, halving the row once a count reaches STRATEGY_COUNT_LIMIT.
+ */
+static void strategyCount(uint16_t counts[3], int index) {
+
+    if (++counts[index] < STRATEGY_COUNT_LIMIT)
+        return;
+
+    for (int i = 0; i < 3; i++)
+        counts[i] >>= 1;}
+
+int strategyChoose(Strategy *strategy, Rng *rng) {
+
+    int prediction = 0;
+
+    switch (strategy->spec.kind) {
+
+        case STRATEGY_FREQUENCY:
+            prediction = strategyPredict(strategy->frequency, rng);
+            break;
+
+        case STRATEGY_MARKOV:
+            if (strategy->seen >= (uint32_t) strategy->spec.order)
+                prediction = strategyPredict(strategyMarkovRow(strategy, strategy->spec.order), rng);
+            break;
+
+        case STRATEGY_ENSEMBLE: {
+            int best = -1;
+
+            // Every predictor guesses; the one whose counter-moves have scored best recently is followed.
+            strategy->predictions[0] = (int8_t) strategyPredict(strategy->frequency, rng);
+
+            for (int order = 1; order <= STRATEGY_MAX_ORDER; order++)
+                strategy->predictions[order] = (int8_t) ((strategy->seen >= (uint32_t) order) ? strategyPredict(strategyMarkovRow(strategy, order), rng) : 0);
+
+            for (int i = 0; i < STRATEGY_PREDICTORS; i++)
+                if ((strategy->predictions[i] != 0) && ((best < 0) || (strategy->scores[i] > strategy->scores[best])))
+                    best = i;
+
+            if ((best >= 0) && (strategy->scores[best] > 0))
+                prediction = strategy->predictions[best];
+
+            break;}
+
+        case STRATEGY_CYCLE:
+            return (int) (strategy->moves % 3) + 1;
+
+        default:
+            break;}
+
+    return (prediction != 0) ? strategyCounter(prediction) : (int) rngBounded(rng, 3) + 1;}
+
+void strategyObserve(Strategy *strategy, int opponentChoice) {
+
+    int move = opponentChoice - 1;
+
+    switch (strategy->spec.kind) {
+
+        case STRATEGY_FREQUENCY:
+            strategyCount(strategy->frequency, move);
+            break;
+
+        case STRATEGY_MARKOV:
+            if (strategy->seen >= (uint32_t) strategy->spec.order)
+                strategyCount(strategyMarkovRow(strategy, strategy->spec.order), move);
+            break;
+
+        case STRATEGY_ENSEMBLE:
+            strategyCount(strategy->frequency, move);
+
+            for (int order = 1; order <= STRATEGY_MAX_ORDER; order++)
+                if (strategy->seen >= (uint32_t) order)
+                    strategyCount(strategyMarkovRow(strategy, order), move);
+
+            // Score what each predictor's counter-move would have done this round.
+            for (int i = 0; i < STRATEGY_PREDICTORS; i++)
+                if (strategy->predictions[i] != 0) {
+                    int outcome = resolveRound(strategyCounter(strategy->predictions[i]), opponentChoice);
+
+                    strategy->scores[i] += ((outcome == ROUND_PLAYER_WINS) - (outcome == ROUND_COMPUTER_WINS)) * 256 - (strategy->scores[i] >> STRATEGY_SCORE_DECAY);}
+
+            break;
+
+        default:
+            break;}
+
+    strategy->history = (strategy->history * 3 + (uint32_t) move) % STRATEGY_CONTEXTS;
+    strategy->seen += (strategy->seen < STRATEGY_MAX_ORDER);
+    strategy->moves++;}
+
+void simulateSeries(long long series, int bestOf, int (*resolver)(int, int), Rng *rng, SimulationResult *result) {
+
+    int n = (bestOf + 1) / 2;   // Number of wins required to take a series
+
+    for (long long s = 0; s < series; s++) {
+
+        int wins[3] = {0};  // Rounds per outcome, indexed by ROUND_TIE, ROUND_PLAYER_WINS and ROUND_COMPUTER_WINS
+
+        // Same termination rule as the interactive game loop in main().
+        while ((wins[ROUND_PLAYER_WINS] < n) && (wins[ROUND_COMPUTER_WINS] < n))
+            wins[resolver((int) rngBounded(rng, 3) + 1, (int) rngBounded(rng, 3) + 1)]++;
+
+        result->playerRounds += wins[ROUND_PLAYER_WINS];
+        result->computerRounds += wins[ROUND_COMPUTER_WINS];
+        result->ties += wins[ROUND_TIE];
+        result->playerSeries += (wins[ROUND_PLAYER_WINS] == n);
+        result->computerSeries += (wins[ROUND_COMPUTER_WINS] == n);}}
+
+void simulateStrategySeries(long long series, int bestOf, const StrategySpec *player, const StrategySpec *computer, int (*resolver)(int, int), Rng *rng, SimulationResult *result) {
+
+    int n = (bestOf + 1) / 2;   // Number of wins required to take a series
+    Strategy playerStrategy, computerStrategy;
+
+    strategyInit(&playerStrategy, player);
+    strategyInit(&computerStrategy, computer);
+
+    for (long long s = 0; s < series; s++) {
+
+        int wins[3] = {0};  // Rounds per outcome, indexed by ROUND_TIE, ROUND_PLAYER_WINS and ROUND_COMPUTER_WINS
+
+        while ((wins[ROUND_PLAYER_WINS] < n) && (wins[ROUND_COMPUTER_WINS] < n)) {
+
+            if (wins[ROUND_TIE] + wins[ROUND_PLAYER_WINS] + wins[ROUND_COMPUTER_WINS] == STRATEGY_MAX_SERIES_ROUNDS) {
+                result->drawnSeries++;
+                break;}
+
+            int playerChoice = strategyChoose(&playerStrategy, rng);
+            int computerChoice = strategyChoose(&computerStrategy, rng);
+
+            wins[resolver(playerChoice, computerChoice)]++;
+            strategyObserve(&playerStrategy, computerChoice);
+            strategyObserve(&computerStrategy, playerChoice);}
+
+        result->playerRounds += wins[ROUND_PLAYER_WINS];
+        result->computerRounds += wins[ROUND_COMPUTER_WINS];
+        result->ties += wins[ROUND_TIE];
+        result->playerSeries += (wins[ROUND_PLAYER_WINS] == n);
+        result->computerSeries += (wins[ROUND_COMPUTER_WINS] == n);}}
+
+void simulateVariantSeries(long long series, int bestOf, const Variant *variant, Rng *rng, SimulationResult *result) {
+
+    int n = (bestOf + 1) / 2;   // Number of wins required to take a series
+
+    for (long long s = 0; s < series; s++) {
+
+        int wins[3] = {0};  // Rounds per outcome, indexed by ROUND_TIE, ROUND_PLAYER_WINS and ROUND_COMPUTER_WINS
+
+        while ((wins[ROUND_PLAYER_WINS] < n) && (wins[ROUND_COMPUTER_WINS] < n)) {
+            int playerChoice = (int) rngBounded(rng, (uint32_t) variant->moves) + 1;
+            int computerChoice = (int) rngBounded(rng, (uint32_t) variant->moves) + 1;
+
+            wins[variantResolve(variant, playerChoice, computerChoice)]++;}
+
+        result->playerRounds += wins[ROUND_PLAYER_WINS];
+        result->computerRounds += wins[ROUND_COMPUTER_WINS];
+        result->ties += wins[ROUND_TIE];
+        result->playerSeries += (wins[ROUND_PLAYER_WINS] == n);
+        result->computerSeries += (wins[ROUND_COMPUTER_WINS] == n);}}
+
+/**
+ * @brief Draws one round for a single lane of a batch stream.
+ *
+ * Reference semantics shared by every batch kernel: the upper 32 bits of a
+ * xoshiro256** output pick the player's move and the lower 32 bits the
+ * computer's, each with Lemire's method. If either half falls into the
+ * biased zone (probability 2^-31) the whole output is discarded and the
+ * lane draws again.
+ *
+ * @return ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+static int batchLaneRound(BatchRng *rng, int lane) {
+
+    uint64_t state[4];
+    uint64_t playerProduct, computerProduct;
+
+    for (int w = 0; w < 4; w++)
+        state[w] = rng->state[w][lane];
+
+    do {
+        uint64_t x = xoshiroNext(state);
+        playerProduct = (x >> 32) * 3;
+        computerProduct = (x & 0xffffffffULL) * 3;}
+    while (((uint32_t) playerProduct == 0) || ((uint32_t) computerProduct == 0));  // 2^32 mod 3 == 1, so only a low half of 0 is biased
+
+    for (int w = 0; w < 4; w++)
+        rng->state[w][lane] = state[w];
+
+    return (int) (((playerProduct >> 32) - (computerProduct >> 32) + 3) % 3);}
+
+/**
+ * @brief Plays one round on every lane with scalar code.
+ */
+static void batchStepScalar(BatchRng *rng, SimulationResult *result) {
+
+    long long wins[3] = {0};
+
+    for (int lane = 0; lane < BATCH_LANES; lane++)
+        wins[batchLaneRound(rng, lane)]++;
+
+    result->ties += wins[ROUND_TIE];
+    result->playerRounds += wins[ROUND_PLAYER_WINS];
+    result->computerRounds += wins[ROUND_COMPUTER_WINS];}
+
+static int batchKernelAlwaysAvailable(void) {
+
+    return 1;}
+
+static void batchKernelScalar(BatchRng *rng, long long steps, SimulationResult *result) {
+
+    for (long long i = 0; i < steps; i++)
+        batchStepScalar(rng, result);}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+static int batchKernelSse2Available(void) {
+
+    return __builtin_cpu_supports("sse2");}
+
+static int batchKernelAvx2Available(void) {
+
+    return __builtin_cpu_supports("avx2");}
+
+/**
+ * @brief SSE2 batch kernel: four vectors of two xoshiro256** lanes each.
+ */
+__attribute__((target("sse2")))
+static void batchKernelSse2(BatchRng *rng, long long steps, SimulationResult *result) {
+
+    const __m128i three = _mm_set1_epi64x(3);
+    const __m128i two = _mm_set1_epi64x(2);
+    const __m128i lowMask = _mm_set1_epi64x(0xffffffffLL);
+    const __m128i zero = _mm_setzero_si128();
+    long long wins = 0, losses = 0;
+    __m128i s[4][4];    // [vector][state word]
+
+    for (int v = 0; v < 4; v++)
+        for (int w = 0; w < 4; w++)
+            s[v][w] = _mm_load_si128((const __m128i *) &rng->state[w][v * 2]);
+
+    for (long long i = 0; i < steps; i++) {
+
+        __m128i next[4][4], outcome[4];
+        __m128i reject = zero;
+
+        for (int v = 0; v < 4; v++) {
+            // result = rotl(s1 * 5, 7) * 9
+            __m128i x = _mm_add_epi64(_mm_slli_epi64(s[v][1], 2), s[v][1]);
+            x = _mm_or_si128(_mm_slli_epi64(x, 7), _mm_srli_epi64(x, 57));
+            x = _mm_add_epi64(_mm_slli_epi64(x, 3), x);
+
+            __m128i t = _mm_slli_epi64(s[v][1], 17);
+            next[v][2] = _mm_xor_si128(s[v][2], s[v][0]);
+            next[v][3] = _mm_xor_si128(s[v][3], s[v][1]);
+            next[v][1] = _mm_xor_si128(s[v][1], next[v][2]);
+            next[v][0] = _mm_xor_si128(s[v][0], next[v][3]);
+            next[v][2] = _mm_xor_si128(next[v][2], t);
+            next[v][3] = _mm_or_si128(_mm_slli_epi64(next[v][3], 45), _mm_srli_epi64(next[v][3], 19));
+
+            // Lemire: move = (half * 3) >> 32, biased when the low 32 bits of the product are 0.
+            __m128i playerProduct = _mm_mul_epu32(_mm_srli_epi64(x, 32), three);
+            __m128i computerProduct = _mm_mul_epu32(x, three);
+            reject = _mm_or_si128(reject, _mm_and_si128(_mm_cmpeq_epi32(playerProduct, zero), lowMask));
+            reject = _mm_or_si128(reject, _mm_and_si128(_mm_cmpeq_epi32(computerProduct, zero), lowMask));
+
+            // outcome = (p - c + 3) % 3, with the modulo done as a conditional subtraction.
+            __m128i d = _mm_add_epi64(_mm_sub_epi64(_mm_srli_epi64(playerProduct, 32), _mm_srli_epi64(computerProduct, 32)), three);
+            outcome[v] = _mm_sub_epi64(d, _mm_and_si128(_mm_cmpgt_epi32(d, two), three));}
+
+        if (_mm_movemask_epi8(reject) != 0) {
+            // A lane has to redraw: replay this step with the reference code.
+            for (int v = 0; v < 4; v++)
+                for (int w = 0; w < 4; w++)
+                    _mm_store_si128((__m128i *) &rng->state[w][v * 2], s[v][w]);
+
+            batchStepScalar(rng, result);
+
+            for (int v = 0; v < 4; v++)
+                for (int w = 0; w < 4; w++)
+                    s[v][w] = _mm_load_si128((const __m128i *) &rng->state[w][v * 2]);
+
+            continue;}
+
+        for (int v = 0; v < 4; v++) {
+            // Bit 0 of the outcome flags a player win, bit 1 a computer win.
+            wins += __builtin_popcount((unsigned) _mm_movemask_pd(_mm_castsi128_pd(_mm_slli_epi64(outcome[v], 63))));
+            losses += __builtin_popcount((unsigned) _mm_movemask_pd(_mm_castsi128_pd(_mm_slli_epi64(outcome[v], 62))));
+
+            for (int w = 0; w < 4; w++)
+                s[v][w] = next[v][w];}
+
+        result->ties += BATCH_LANES;}
+
+    for (int v = 0; v < 4; v++)
+        for (int w = 0; w < 4; w++)
+            _mm_store_si128((__m128i *) &rng->state[w][v * 2], s[v][w]);
+
+    result->playerRounds += wins;
+    result->computerRounds += losses;
+    result->ties -= wins + losses;}
+
+/**
+ * @brief AVX2 batch kernel: two vectors of four xoshiro256** lanes each.
+ */
+__attribute__((target("avx2")))
+static void batchKernelAvx2(BatchRng *rng, long long steps, SimulationResult *result) {
+
+    const __m256i three = _mm256_set1_epi64x(3);
+    const __m256i two = _mm256_set1_epi64x(2);
+    const __m256i lowMask = _mm256_set1_epi64x(0xffffffffLL);
+    const __m256i zero = _mm256_setzero_si256();
+    long long wins = 0, losses = 0;
+    __m256i s[2][4];    // [vector][state word]
+
+    for (int v = 0; v < 2; v++)
+        for (int w = 0; w < 4; w++)
+            s[v][w] = _mm256_load_si256((const __m256i *) &rng->state[w][v * 4]);
+
+    for (long long i = 0; i < steps; i++) {
+
+        __m256i next[2][4], outcome[2];
+        __m256i reject = zero;
+
+        for (int v = 0; v < 2; v++) {
+            // result = rotl(s1 * 5, 7) * 9
+            __m256i x = _mm256_add_epi64(_mm256_slli_epi64(s[v][1], 2), s[v][1]);
+            x = _mm256_or_si256(_mm256_slli_epi64(x, 7), _mm256_srli_epi64(x, 57));
+            x = _mm256_add_epi64(_mm256_slli_epi64(x, 3), x);
+
+            __m256i t = _mm256_slli_epi64(s[v][1], 17);
+            next[v][2] = _mm256_xor_si256(s[v][2], s[v][0]);
+            next[v][3] = _mm256_xor_si256(s[v][3], s[v][1]);
+            next[v][1] = _mm256_xor_si256(s[v][1], next[v][2]);
+            next[v][0] = _mm256_xor_si256(s[v][0], next[v][3]);
+            next[v][2] = _mm256_xor_si256(next[v][2], t);
+            next[v][3] = _mm256_or_si256(_mm256_slli_epi64(next[v][3], 45), _mm256_srli_epi64(next[v][3], 19));
+
+            // Lemire: move = (half * 3) >> 32, biased when the low 32 bits of the product are 0.
+            __m256i playerProduct = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), three);
+            __m256i computerProduct = _mm256_mul_epu32(x, three);
+            reject = _mm256_or_si256(reject, _mm256_cmpeq_epi64(_mm256_and_si256(playerProduct, lowMask), zero));
+            reject = _mm256_or_si256(reject, _mm256_cmpeq_epi64(_mm256_and_si256(computerProduct, lowMask), zero));
+
+            // outcome = (p - c + 3) % 3, with the modulo done as a conditional subtraction.
+            __m256i d = _mm256_add_epi64(_mm256_sub_epi64(_mm256_srli_epi64(playerProduct, 32), _mm256_srli_epi64(computerProduct, 32)), three);
+            outcome[v] = _mm256_sub_epi64(d, _mm256_and_si256(_mm256_cmpgt_epi64(d, two), three));}
+
+        if (!_mm256_testz_si256(reject, reject)) {
+            // A lane has to redraw: replay this step with the reference code.
+            for (int v = 0; v < 2; v++)
+                for (int w = 0; w < 4; w++)
+                    _mm256_store_si256((__m256i *) &rng->state[w][v * 4], s[v][w]);
+
+            batchStepScalar(rng, result);
+
+            for (int v = 0; v < 2; v++)
+                for (int w = 0; w < 4; w++)
+                    s[v][w] = _mm256_load_si256((const __m256i *) &rng->state[w][v * 4]);
+
+            continue;}
+
+        for (int v = 0; v < 2; v++) {
+            // Bit 0 of the outcome flags a player win, bit 1 a computer win.
+            wins += __builtin_popcount((unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_slli_epi64(outcome[v], 63))));
+            losses += __builtin_popcount((unsigned) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_slli_epi64(outcome[v], 62))));
+
+            for (int w = 0; w < 4; w++)
+                s[v][w] = next[v][w];}
+
+        result->ties += BATCH_LANES;}
+
+    for (int v = 0; v < 2; v++)
+        for (int w = 0; w < 4; w++)
+            _mm256_store_si256((__m256i *) &rng->state[w][v * 4], s[v][w]);
+
+    result->playerRounds += wins;
+    result->computerRounds += losses;
+    result->ties -= wins + losses;}
+
+#endif
+
+#if defined(__aarch64__)
+
+/**
+ * @brief NEON batch kernel: four vectors of two xoshiro256** lanes each.
+ *
+ * NEON has no movemask, so wins and losses are accumulated per lane and
+ * summed once at the end.
+ */
+static void batchKernelNeon(BatchRng *rng, long long steps, SimulationResult *result) {
+
+    const uint64x2_t three = vdupq_n_u64(3);
+    const uint64x2_t two = vdupq_n_u64(2);
+    const uint64x2_t one = vdupq_n_u64(1);
+    const uint32x2_t three32 = vdup_n_u32(3);
+    uint64x2_t winsAccumulator = vdupq_n_u64(0), lossesAccumulator = vdupq_n_u64(0);
+    uint64x2_t s[4][4]; // [vector][state word]
+
+    for (int v = 0; v < 4; v++)
+        for (int w = 0; w < 4; w++)
+            s[v][w] = vld1q_u64(&rng->state[w][v * 2]);
+
+    for (long long i = 0; i < steps; i++) {
+
+        uint64x2_t next[4][4], outcome[4];
+        uint32x2_t reject = vdup_n_u32(0);
+
+        for (int v = 0; v < 4; v++) {
+            // result = rotl(s1 * 5, 7) * 9
+            uint64x2_t x = vaddq_u64(vshlq_n_u64(s[v][1], 2), s[v][1]);
+            x = vorrq_u64(vshlq_n_u64(x, 7), vshrq_n_u64(x, 57));
+            x = vaddq_u64(vshlq_n_u64(x, 3), x);
+
+            uint64x2_t t = vshlq_n_u64(s[v][1], 17);
+            next[v][2] = veorq_u64(s[v][2], s[v][0]);
+            next[v][3] = veorq_u64(s[v][3], s[v][1]);
+            next[v][1] = veorq_u64(s[v][1], next[v][2]);
+            next[v][0] = veorq_u64(s[v][0], next[v][3]);
+            next[v][2] = veorq_u64(next[v][2], t);
+            next[v][3] = vorrq_u64(vshlq_n_u64(next[v][3], 45), vshrq_n_u64(next[v][3], 19));
+
+            // Lemire: move = (half * 3) >> 32, biased when the low 32 bits of the product are 0.
+            uint64x2_t playerProduct = vmull_u32(vshrn_n_u64(x, 32), three32);
+            uint64x2_t computerProduct = vmull_u32(vmovn_u64(x), three32);
+            reject = vorr_u32(reject, vceq_u32(vmovn_u64(playerProduct), vdup_n_u32(0)));
+            reject = vorr_u32(reject, vceq_u32(vmovn_u64(computerProduct), vdup_n_u32(0)));
+
+            // outcome = (p - c + 3) % 3, with the modulo done as a conditional subtraction.
+            uint64x2_t d = vaddq_u64(vsubq_u64(vshrq_n_u64(playerProduct, 32), vshrq_n_u64(computerProduct, 32)), three);
+            outcome[v] = vsubq_u64(d, vandq_u64(vcgtq_u64(d, two), three));}
+
+        if (vget_lane_u64(vreinterpret_u64_u32(reject), 0) != 0) {
+            // A lane has to redraw: replay this step with the reference code.
+            for (int v = 0; v < 4; v++)
+                for (int w = 0; w < 4; w++)
+                    vst1q_u64(&rng->state[w][v * 2], s[v][w]);
+
+            batchStepScalar(rng, result);
+
+            for (int v = 0; v < 4; v++)
+                for (int w = 0; w < 4; w++)
+                    s[v][w] = vld1q_u64(&rng->state[w][v * 2]);
+
+            continue;}
+
+        for (int v = 0; v < 4; v++) {
+            winsAccumulator = vaddq_u64(winsAccumulator, vandq_u64(outcome[v], one));
+            lossesAccumulator = vaddq_u64(lossesAccumulator, vshrq_n_u64(outcome[v], 1));
+
+            for (int w = 0; w < 4; w++)
+                s[v][w] = next[v][w];}
+
+        result->ties += BATCH_LANES;}
+
+    for (int v = 0; v < 4; v++)
+        for (int w = 0; w < 4; w++)
+            vst1q_u64(&rng->state[w][v * 2], s[v][w]);
+
+    long long wins = (long long) (vgetq_lane_u64(winsAccumulator, 0) + vgetq_lane_u64(winsAccumulator, 1));
+    long long losses = (long long) (vgetq_lane_u64(lossesAccumulator, 0) + vgetq_lane_u64(lossesAccumulator, 1));
+
+    result->playerRounds += wins;
+    result->computerRounds += losses;
+    result->ties -= wins + losses;}
+
+#endif
+
+// Batch kernels in order of preference; the scalar reference must stay last.
+static const BatchKernel batchKernels[] = {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    {"avx2", batchKernelAvx2Available, batchKernelAvx2},
+    {"sse2", batchKernelSse2Available, batchKernelSse2},
+#endif
+#if defined(__aarch64__)
+    {"neon", batchKernelAlwaysAvailable, batchKernelNeon},
+#endif
+    {"scalar", batchKernelAlwaysAvailable, batchKernelScalar}};
+
+#define BATCH_KERNEL_COUNT ((int) (sizeof batchKernels / sizeof batchKernels[0]))
+
+const BatchKernel *batchKernelFind(const char *name) {
+
+    for (int i = 0; i < BATCH_KERNEL_COUNT; i++)
+        if ((name == NULL) ? batchKernels[i].available() : (strcmp(batchKernels[i].name, name) == 0))
+            return &batchKernels[i];
+
+    return NULL;}
+
+const BatchKernel *batchKernelScalarReference(void) {
+
+    return &batchKernels[BATCH_KERNEL_COUNT - 1];}
+
+void batchRngInit(BatchRng *rng, uint64_t seed, unsigned stream) {
+
+    Rng lane;
+
+    rngInit(&lane, RNG_XOSHIRO256, seed, stream * BATCH_LANES);
+
+    // Consecutive lanes are one jump (2^128 draws) apart.
+    for (int l = 0; l < BATCH_LANES; l++) {
+
+        for (int w = 0; w < 4; w++)
+            rng->state[w][l] = lane.state[w];
+
+        xoshiroJump(lane.state);}}
+
+void simulateRounds(long long rounds, const BatchKernel *kernel, BatchRng *rng, SimulationResult *result) {
+
+    kernel->run(rng, rounds / BATCH_LANES, result);
+
+    // The last partial step always runs on scalar code so every kernel ends in the same state.
+    for (int lane = 0; lane < rounds % BATCH_LANES; lane++) {
+
+        int outcome = batchLaneRound(rng, lane);
+
+        result->ties += (outcome == ROUND_TIE);
+        result->playerRounds += (outcome == ROUND_PLAYER_WINS);
+        result->computerRounds += (outcome == ROUND_COMPUTER_WINS);}}
+
+/**
+ * @brief Thread entry point: plays the worker's share of the series or rounds.
+ */
+static void *simulationWorkerMain(void *argument) {
+
+    SimulationWorker *worker = argument;
+
+    if (worker->kernel != NULL)
+        simulateRounds(worker->rounds, worker->kernel, &worker->batchRng, &worker->result);
+
+    else if (worker->variant != NULL)
+        simulateVariantSeries(worker->series, worker->bestOf, worker->variant, &worker->rng, &worker->result);
+
+    else if ((worker->playerStrategy.kind == STRATEGY_RANDOM) && (worker->computerStrategy.kind == STRATEGY_RANDOM))
+        simulateSeries(worker->series, worker->bestOf, worker->resolver, &worker->rng, &worker->result);
+
+    else
+        simulateStrategySeries(worker->series, worker->bestOf, &worker->playerStrategy, &worker->computerStrategy, worker->resolver, &worker->rng, &worker->result);
+
+    return NULL;}
+
+double runSimulationJob(const SimulationJob *job, SimulationResult *result) {
+
+    struct timespec start, end;
+    int threads = job->threads;
+    SimulationWorker *workers = aligned_alloc(CACHE_LINE_SIZE, (size_t) threads * sizeof *workers);
+
+    if (workers == NULL) {
+        perror("Worker allocation failed");
+        return -1.0;}
+
+    for (int i = 0; i < threads; i++) {
+        memset(&workers[i].result, 0, sizeof workers[i].result);
+        rngInit(&workers[i].rng, job->rngKind, job->seed, (unsigned) i);  // Same seed for every resolver, so they play identical games
+        workers[i].series = job->series / threads + (i < job->series % threads);
+        workers[i].bestOf = job->bestOf;
+        workers[i].resolver = job->resolver;
+        workers[i].playerStrategy = job->playerStrategy;
+        workers[i].computerStrategy = job->computerStrategy;
+        workers[i].variant = job->variant;
+        workers[i].kernel = job->kernel;
+        workers[i].rounds = job->rounds / threads + (i < job->rounds % threads);
+
+        if (job->kernel != NULL)
+            batchRngInit(&workers[i].batchRng, job->seed, (unsigned) i);}
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Worker 0 runs on the calling thread, the others get a thread each.
+    int started = 1;
+
+    for (; started < threads; started++)
+        if (pthread_create(&workers[started].thread, NULL, simulationWorkerMain, &workers[started]) != 0)
+            break;
+
+    if (started == threads)
+        simulationWorkerMain(&workers[0]);
+
+    for (int i = 1; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (started != threads) {
+        fprintf(stderr, "Could not start simulation thread %i...\n", started);
+        free(workers);
+        return -1.0;}
+
+    // Single reduction once every worker has finished.
+    for (int i = 0; i < threads; i++) {
+        result->playerSeries += workers[i].result.playerSeries;
+        result->computerSeries += workers[i].result.computerSeries;
+        result->playerRounds += workers[i].result.playerRounds;
+        result->computerRounds += workers[i].result.computerRounds;
+        result->ties += workers[i].result.ties;
+        result->drawnSeries += workers[i].result.drawnSeries;}
+
+    free(workers);
+
+    return (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;}
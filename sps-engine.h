@@ -0,0 +1,559 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-engine.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Round resolution (classic and N-move variants), random number generators, the computer's
+ * strategies and the headless simulator (single series, batch kernels and
+ * the thread pool). Nothing in
+ * here performs I/O on the game's terminal, so it is shared by the game
+ * and the benchmark.
+ */
+
+#ifndef SPS_ENGINE_H
+#define SPS_ENGINE_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint32_t, uint64_t) for the random number generators
+
+// Define constants for the engine
+// Game rules shared by the interactive game and the server
+#define MAX_PLAYER_NAME 20  // Maximum characters allowed for the player's name (including null terminator).
+#define MAX_CHOICE_ATTEMPTS 5   // Maximum attempts a player has to enter a valid Stone/Paper/Scissors choice.
+#define MAX_WIN_MESSAGE_BUFFER 120  // Buffer size for the final win/loss message string passed to the banner renderer.
+#define MAX_CHOICE_INPUT_LENGTH 9   // Max characters for player's choice input (e.g., "Scissors" is 7 chars + newline + null).
+// Outcomes of a single round as returned by resolveRound()
+#define ROUND_TIE 0 // Both sides made the same choice.
+#define ROUND_PLAYER_WINS 1 // The player's choice beats the computer's.
+#define ROUND_COMPUTER_WINS 2   // The computer's choice beats the player's.
+// Results of choiceTokenizerFeed() other than a choice (1 to 3)
+#define CHOICE_PENDING 0    // No complete line yet: feed more bytes.
+#define CHOICE_INVALID -1   // The line was not a choice; the player may try again.
+#define CHOICE_EXHAUSTED -2 // The line was the MAX_CHOICE_ATTEMPTS-th invalid one in a row.
+#define BATCH_LANES 8   // Independent random streams advanced together by the batch kernels.
+// Game variants with more moves
+#define VARIANT_MAX_MOVES 101   // Moves of the largest variant (RPS-101).
+#define VARIANT_WORDS ((VARIANT_MAX_MOVES + 63) / 64)   // 64-bit words in a row of the outcome bit matrix.
+#define VARIANT_MAX_NAME 16 // Longest move name of any variant, including the null terminator.
+#define VARIANT_HASH_BUCKETS 64 // Buckets of the perfect hash of move names, each with its own displacement.
+#define VARIANT_HASH_SLOTS 256  // Slots of the perfect hash of move names (a power of two above 2 * VARIANT_MAX_MOVES).
+// Strategies of the computer opponent
+#define STRATEGY_MAX_ORDER 4    // Longest history, in opponent moves, a Markov model conditions on.
+#define STRATEGY_DEFAULT_ORDER 2    // Order of "markov" when no order is given.
+#define STRATEGY_CONTEXTS 81    // Distinct histories of STRATEGY_MAX_ORDER moves (3^STRATEGY_MAX_ORDER).
+#define STRATEGY_PREDICTORS (1 + STRATEGY_MAX_ORDER)    // Predictors of the ensemble: frequency, then Markov orders 1 and up.
+#define STRATEGY_COUNT_LIMIT 1024   // A row of counts is halved when one reaches this, so old habits fade.
+#define STRATEGY_SCORE_DECAY 4  // Ensemble scores lose 1/2^STRATEGY_SCORE_DECAY of their value every round.
+#define STRATEGY_MAX_SERIES_ROUNDS 10000    // Rounds after which a simulated series between strategies is called a draw (two deterministic strategies can tie forever).
+
+// Data types
+/**
+ * @brief Random number generator algorithms selectable with '--rng'.
+ */
+typedef enum {
+    RNG_XOSHIRO256 = 0,     // xoshiro256** (default)
+    RNG_PCG32               // PCG32 (XSH-RR variant)
+} RngKind;
+
+/**
+ * @brief State of one random number stream.
+ *
+ * Every thread owns its own Rng, so no locks or shared state are involved
+ * when drawing numbers.
+ */
+typedef struct {
+    RngKind kind;       // Algorithm driving this stream
+    uint64_t state[4];  // xoshiro256** uses all four words, PCG32 uses state[0] (state) and state[1] (increment)
+} Rng;
+
+/**
+ * @brief Game variants selectable with '--variant'.
+ */
+typedef enum {
+    VARIANT_CLASSIC = 0,    // Stone, Paper, Scissors
+    VARIANT_RPSLS,          // Stone, Paper, Scissors, Spock, Lizard
+    VARIANT_RPS101,         // RPS-101: 101 moves, each beating 50 others
+    VARIANT_COUNT
+} VariantId;
+
+/**
+ * @brief How the moves of a variant beat each other; every move beats exactly half of the others.
+ */
+typedef enum {
+    VARIANT_RULE_PARITY = 0,    // Move a beats move b if (a - b) mod N is odd
+    VARIANT_RULE_FOLLOWING      // Move a beats the (N - 1) / 2 moves following it, wrapping around
+} VariantRule;
+
+/**
+ * @brief A cyclic game of an odd number N of moves, numbered 1 to N.
+ *
+ * Outcomes are precomputed into an N x N bit matrix, and move names are
+ * looked up through a perfect hash (hash, then displace) built for the
+ * variant's names, so a round or a parse costs the same for any N.
+ */
+typedef struct {
+    VariantId id;                   // Identifier of the variant
+    const char *name;               // Name accepted by '--variant'
+    int moves;                      // N
+    VariantRule rule;               // Rule the outcome matrix is built from
+    const char *const *moveNames;   // Name of each move, indexed by (move - 1)
+    uint64_t beats[VARIANT_MAX_MOVES][VARIANT_WORDS];   // Bit (b - 1) of row (a - 1) is set if move a beats move b
+    uint16_t displacements[VARIANT_HASH_BUCKETS];       // Seed of the second hash of each bucket
+    uint8_t slots[VARIANT_HASH_SLOTS];                  // Move whose name hashes to each slot, or 0
+} Variant;
+
+/**
+ * @brief Resumable reader of the player's choices from a byte stream.
+ *
+ * Bytes can arrive in chunks of any size, from a terminal or a non-blocking
+ * socket. Like fgets into a MAX_CHOICE_INPUT_LENGTH buffer, only the first
+ * bytes of a line are kept and the rest up to the newline is discarded;
+ * other variants keep up to VARIANT_MAX_NAME - 1 bytes.
+ */
+typedef struct {
+    char token[VARIANT_MAX_NAME - 1];   // Start of the line being received
+    uint8_t variant;    // VariantId of the moves accepted (zero is the classic game)
+    uint8_t length;     // Bytes in token
+    uint8_t attempts;   // Invalid lines received in a row
+} ChoiceTokenizer;
+
+/**
+ * @brief Ways a side can pick its moves.
+ */
+typedef enum {
+    STRATEGY_RANDOM = 0,    // Uniform random (the original computer)
+    STRATEGY_FREQUENCY,     // Beat the opponent's most frequent move
+    STRATEGY_MARKOV,        // Beat the move the opponent most often played after its last 'order' moves
+    STRATEGY_ENSEMBLE,      // Follow whichever of the frequency and Markov predictors has recently scored best
+    STRATEGY_CYCLE          // Stone, Paper, Scissors in turn (a predictable opponent for testing the others)
+} StrategyKind;
+
+/**
+ * @brief A strategy as selected on the command line.
+ */
+typedef struct {
+    StrategyKind kind;  // Algorithm
+    int order;          // History length of STRATEGY_MARKOV (1 to STRATEGY_MAX_ORDER)
+} StrategySpec;
+
+/**
+ * @brief State of one side's strategy.
+ *
+ * Every table has a fixed size and is updated in place after each round,
+ * so choosing a move costs the same however long the game has run.
+ */
+typedef struct {
+    StrategySpec spec;                  // Strategy being played
+    uint32_t history;                   // Last STRATEGY_MAX_ORDER opponent moves as base-3 digits, newest lowest
+    uint32_t seen;                      // Opponent moves observed, up to STRATEGY_MAX_ORDER
+    uint32_t moves;                     // Rounds played (wraps around)
+    uint16_t frequency[3];              // Opponent moves, by (choice - 1)
+    uint16_t markov[STRATEGY_MAX_ORDER][STRATEGY_CONTEXTS][3];   // [order - 1][last 'order' moves][next move]
+    int32_t scores[STRATEGY_PREDICTORS];    // Decayed score of each ensemble predictor's counter-move
+    int8_t predictions[STRATEGY_PREDICTORS];    // Move each ensemble predictor expected this round, or 0
+} Strategy;
+
+/**
+ * @brief Aggregate counters produced by a headless simulation run.
+ */
+typedef struct {
+    long long playerSeries;     // Number of series won by the player
+    long long computerSeries;   // Number of series won by the computer
+    long long playerRounds;     // Number of rounds won by the player
+    long long computerRounds;   // Number of rounds won by the computer
+    long long ties;             // Number of tied rounds
+    long long drawnSeries;      // Number of series stopped at STRATEGY_MAX_SERIES_ROUNDS rounds
+} SimulationResult;
+
+/**
+ * @brief Random number streams of the batch kernels.
+ *
+ * BATCH_LANES xoshiro256** generators stored word-major (state[word][lane]),
+ * so one vector load fetches the same state word of several lanes. Every
+ * kernel uses the same lanes, which keeps their results identical for a
+ * given seed whatever the vector width.
+ */
+typedef struct {
+    _Alignas(32) uint64_t state[4][BATCH_LANES];
+} BatchRng;
+
+/**
+ * @brief A batch round kernel and its runtime availability check.
+ */
+typedef struct {
+    const char *name;                   // Name accepted by '--kernel'
+    int (*available)(void);             // Returns non-zero if the CPU supports the kernel
+    void (*run)(BatchRng *rng, long long steps, SimulationResult *result);  // Plays 'steps' rounds on every lane
+} BatchKernel;
+
+/**
+ * @brief One headless simulation run, as played by runSimulationJob.
+ */
+typedef struct {
+    long long series;           // Number of best-of series to play (ignored when a kernel is given)
+    int bestOf;                 // 'Best-of' length of every series
+    int (*resolver)(int, int);  // Round resolver used for the series
+    long long rounds;           // Number of independent rounds to play with the batch kernel
+    const BatchKernel *kernel;  // Batch kernel to use, or NULL to play series
+    uint64_t seed;              // Seed shared by every worker
+    RngKind rngKind;            // Random number generator algorithm of the series
+    int threads;                // Number of workers
+    StrategySpec playerStrategy;    // Strategy of the player in the series (zero is random)
+    StrategySpec computerStrategy;  // Strategy of the computer in the series (zero is random)
+    const Variant *variant;     // Variant of the series between two random players, or NULL for the classic game
+} SimulationJob;
+
+// Function prototypes
+/**
+ * @brief Generates a random integer within a specified range (inclusive).
+ *
+ * This function draws from the calling thread's default stream (seeded by
+ * rngSeedDefault in main) without modulo bias.
+ *
+ * @param min The minimum value for the random number (inclusive).
+ * @param max The maximum value for the random number (inclusive).
+ * @return A random integer between min and max (inclusive).
+ */
+int randomNumber(int min, int max);
+
+/**
+ * @brief Initialises a random number stream.
+ *
+ * The seed is expanded with SplitMix64, so any 64-bit value (including 0)
+ * gives a well mixed state. Streams with the same seed but different stream
+ * indices are independent: xoshiro256** streams are 2^128 draws apart (jump
+ * function) and PCG32 streams use distinct increments.
+ *
+ * @param rng Pointer to the stream to initialise.
+ * @param kind Algorithm to use.
+ * @param seed Seed shared by all streams of a run.
+ * @param stream Index of the stream (e.g. the thread number).
+ */
+void rngInit(Rng *rng, RngKind kind, uint64_t seed, unsigned stream);
+
+/**
+ * @brief Draws 32 uniformly distributed random bits from a stream.
+ *
+ * @param rng Pointer to the stream.
+ * @return A random 32-bit value.
+ */
+uint32_t rngNext32(Rng *rng);
+
+/**
+ * @brief Draws a uniformly distributed integer in [0, range) without modulo bias.
+ *
+ * Uses Lemire's multiply-and-shift method, which only needs a division in
+ * the rare case a draw falls into the biased zone and has to be rejected.
+ *
+ * @param rng Pointer to the stream.
+ * @param range Number of possible values (must be non-zero).
+ * @return A random integer between 0 and range - 1 (inclusive).
+ */
+uint32_t rngBounded(Rng *rng, uint32_t range);
+
+/**
+ * @brief Returns the calling thread's default stream, the one randomNumber() draws from.
+ */
+Rng *rngDefault(void);
+
+/**
+ * @brief Seeds the calling thread's default stream used by randomNumber().
+ *
+ * @param kind Algorithm to use.
+ * @param seed Seed of the stream.
+ */
+void rngSeedDefault(RngKind kind, uint64_t seed);
+
+/**
+ * @brief Derives a seed that differs between processes started at the same time.
+ *
+ * Mixes the nanosecond wall clock with the process id.
+ *
+ * @return A 64-bit seed.
+ */
+uint64_t rngEntropySeed(void);
+
+/**
+ * @brief Converts the text a player typed into a choice.
+ *
+ * The comparison is case-insensitive and the text must match a choice
+ * exactly (no surrounding whitespace). The length and first letter select
+ * the only candidate, so at most one comparison is made.
+ *
+ * @param input Text typed by the player, without the newline (need not be null-terminated).
+ * @param length Number of bytes of input.
+ * @return 1 for "Stone", 2 for "Paper", 3 for "Scissors", or 0 if the text is not a choice.
+ */
+int parseChoice(const char *input, size_t length);
+
+/**
+ * @brief Resets a choice tokenizer to the classic game: no partial line and no invalid attempts.
+ *
+ * @param tokenizer Pointer to the tokenizer.
+ */
+void choiceTokenizerInit(ChoiceTokenizer *tokenizer);
+
+/**
+ * @brief Feeds bytes of player input to a choice tokenizer, up to the end of the first line.
+ *
+ * A carriage return ending the line is ignored. A valid choice resets the
+ * count of invalid attempts, and so does CHOICE_EXHAUSTED.
+ *
+ * @param tokenizer Pointer to the tokenizer.
+ * @param data Bytes received.
+ * @param length Number of bytes.
+ * @param result Set to the choice (1 to 3, or 1 to N in a variant), CHOICE_INVALID or CHOICE_EXHAUSTED if a line ended, CHOICE_PENDING otherwise.
+ * @return Number of bytes consumed: up to and including the first newline, or all of them.
+ */
+size_t choiceTokenizerFeed(ChoiceTokenizer *tokenizer, const char *data, size_t length, int *result);
+
+/**
+ * @brief Ends the line being received as if a newline had arrived (at end of input).
+ *
+ * @param tokenizer Pointer to the tokenizer.
+ * @return The choice (1 to 3, or 1 to N in a variant), CHOICE_INVALID or CHOICE_EXHAUSTED.
+ */
+int choiceTokenizerEndLine(ChoiceTokenizer *tokenizer);
+
+/**
+ * @brief Looks a variant up by its '--variant' name ("rps", "rpsls" or "rps101").
+ *
+ * The tables of every variant are built on the first call to variantFind
+ * or variantGet; later calls only read them, from any thread.
+ *
+ * @param name Name of the variant.
+ * @return The variant, or NULL if there is none of that name.
+ */
+const Variant *variantFind(const char *name);
+
+/**
+ * @brief Returns a variant by identifier.
+ *
+ * @param id Identifier of the variant.
+ * @return The variant.
+ */
+const Variant *variantGet(VariantId id);
+
+/**
+ * @brief Parses the name of a move of a variant typed by the player.
+ *
+ * Like parseChoice the comparison is case-insensitive and the text must
+ * match a name exactly; one perfect hash lookup selects the only
+ * candidate.
+ *
+ * @param variant Pointer to the variant.
+ * @param input Text typed by the player, without the newline (need not be null-terminated).
+ * @param length Number of bytes of input.
+ * @return The move (1 to N), or 0 if the text is not a move of the variant.
+ */
+int variantParseMove(const Variant *variant, const char *input, size_t length);
+
+/**
+ * @brief Decides the outcome of a round of a variant with one lookup in its bit matrix and no branch.
+ *
+ * @param variant Pointer to the variant.
+ * @param playerChoice The player's move (1 to N).
+ * @param computerChoice The computer's move (1 to N).
+ * @return ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+int variantResolve(const Variant *variant, int playerChoice, int computerChoice);
+
+/**
+ * @brief Lists the move names of a variant, e.g. "Stone, Paper, Scissors, Spock or Lizard".
+ *
+ * @param variant Pointer to the variant.
+ * @param buffer Destination buffer (truncated if too small).
+ * @param size Size of the buffer.
+ */
+void variantFormatMoves(const Variant *variant, char *buffer, size_t size);
+
+/**
+ * @brief Formats the final win/loss message shown as a banner at the end of a game.
+ *
+ * @param buffer Destination buffer (MAX_WIN_MESSAGE_BUFFER bytes is always enough for a valid name).
+ * @param size Size of the buffer.
+ * @param playerName Name of the player.
+ * @param playerWins Rounds won by the player.
+ * @param computerWins Rounds won by the computer; the side with more wins is announced as the winner.
+ */
+void formatWinMessage(char *buffer, size_t size, const char *playerName, int playerWins, int computerWins);
+
+/**
+ * @brief Decides the outcome of a single round from both choices.
+ *
+ * This is a pure function: it performs no I/O, keeps no state and never
+ * delays, so it can be shared by the interactive game and the headless
+ * simulator. The outcome is read from a compile-time 3x3 lookup table,
+ * so no data-dependent branch is taken on the (random) choices.
+ *
+ * @param playerChoice The player's choice (1:Stone, 2:Paper, 3:Scissors).
+ * @param computerChoice The computer's choice (1:Stone, 2:Paper, 3:Scissors).
+ * @return ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+int resolveRound(int playerChoice, int computerChoice);
+
+/**
+ * @brief Decides the outcome of a single round with a chain of comparisons.
+ *
+ * Reference implementation of the original nested if/else game logic. It is
+ * kept so that '--compare' can measure the table-driven resolveRound()
+ * against it; both must always agree.
+ *
+ * @param playerChoice The player's choice (1:Stone, 2:Paper, 3:Scissors).
+ * @param computerChoice The computer's choice (1:Stone, 2:Paper, 3:Scissors).
+ * @return ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+int resolveRoundBranchy(int playerChoice, int computerChoice);
+
+/**
+ * @brief Parses a strategy name: random, frequency, markov (or markov1 to markov4), ensemble or cycle.
+ *
+ * @param name Name given on the command line.
+ * @param spec Filled in with the strategy.
+ * @return 0 on success, -1 if the name is not a strategy.
+ */
+int strategyParse(const char *name, StrategySpec *spec);
+
+/**
+ * @brief Formats the name of a strategy as strategyParse accepts it.
+ *
+ * @param spec Pointer to the strategy.
+ * @param buffer Destination buffer.
+ * @param size Size of the buffer.
+ */
+void strategyFormat(const StrategySpec *spec, char *buffer, size_t size);
+
+/**
+ * @brief Resets a side's strategy: no history, empty tables.
+ *
+ * @param strategy Pointer to the state.
+ * @param spec Strategy to play.
+ */
+void strategyInit(Strategy *strategy, const StrategySpec *spec);
+
+/**
+ * @brief Picks the side's next move.
+ *
+ * While a predictor has no data (or no ensemble predictor is ahead), the
+ * move is drawn at random. STRATEGY_RANDOM draws exactly like
+ * randomNumber(1, 3), so it replays the original games for a given seed.
+ *
+ * @param strategy Pointer to the state.
+ * @param rng Stream random moves and tie-breaks are drawn from.
+ * @return The move (1:Stone, 2:Paper, 3:Scissors).
+ */
+int strategyChoose(Strategy *strategy, Rng *rng);
+
+/**
+ * @brief Updates a side's tables with the opponent's move of the round just played.
+ *
+ * @param strategy Pointer to the state.
+ * @param opponentChoice The opponent's move (1 to 3).
+ */
+void strategyObserve(Strategy *strategy, int opponentChoice);
+
+/**
+ * @brief Plays a number of best-of series between two random players with no I/O and no delays.
+ *
+ * The counters of the result are incremented, not overwritten, so a caller
+ * can accumulate several runs into the same structure.
+ *
+ * @param series Number of series to play.
+ * @param bestOf 'Best-of' length of every series (positive odd integer).
+ * @param resolver Round resolver to use (resolveRound or resolveRoundBranchy).
+ * @param rng Pointer to the random number stream both players draw from.
+ * @param result Pointer to the counters to increment.
+ */
+void simulateSeries(long long series, int bestOf, int (*resolver)(int, int), Rng *rng, SimulationResult *result);
+
+/**
+ * @brief Plays a number of best-of series of a variant between two random players.
+ *
+ * Moves are drawn uniformly from 1 to N and resolved with variantResolve,
+ * so a round costs the same whatever the number of moves.
+ *
+ * @param series Number of series to play.
+ * @param bestOf 'Best-of' length of every series (positive odd integer).
+ * @param variant Pointer to the variant.
+ * @param rng Random number stream of the calling thread.
+ * @param result Counters to add the outcomes to.
+ */
+void simulateVariantSeries(long long series, int bestOf, const Variant *variant, Rng *rng, SimulationResult *result);
+
+/**
+ * @brief Plays a number of best-of series between two strategies with no I/O and no delays.
+ *
+ * Both sides keep learning across the series. The counters of the result
+ * are incremented, not overwritten.
+ *
+ * @param series Number of series to play.
+ * @param bestOf 'Best-of' length of every series (positive odd integer).
+ * @param player Strategy of the player.
+ * @param computer Strategy of the computer.
+ * @param resolver Round resolver to use (resolveRound or resolveRoundBranchy).
+ * @param rng Pointer to the random number stream both sides draw from.
+ * @param result Pointer to the counters to increment.
+ */
+void simulateStrategySeries(long long series, int bestOf, const StrategySpec *player, const StrategySpec *computer, int (*resolver)(int, int), Rng *rng, SimulationResult *result);
+
+/**
+ * @brief Initialises the lanes of a batch stream.
+ *
+ * @param rng Pointer to the lanes to initialise.
+ * @param seed Seed shared by all streams of a run.
+ * @param stream Index of the batch stream (e.g. the thread number); it owns
+ * xoshiro256** streams stream * BATCH_LANES to stream * BATCH_LANES + BATCH_LANES - 1.
+ */
+void batchRngInit(BatchRng *rng, uint64_t seed, unsigned stream);
+
+/**
+ * @brief Looks up a batch kernel by name, or picks the best one the CPU supports.
+ *
+ * @param name Kernel name ("avx2", "sse2", "neon" or "scalar"), or NULL for automatic selection.
+ * @return Pointer to the kernel, or NULL if no kernel of that name was compiled in.
+ */
+const BatchKernel *batchKernelFind(const char *name);
+
+/**
+ * @brief Returns the scalar batch kernel that defines the reference results.
+ */
+const BatchKernel *batchKernelScalarReference(void);
+
+/**
+ * @brief Resolves independent random rounds with a batch kernel.
+ *
+ * The rounds are spread over the BATCH_LANES lanes. For the same lanes,
+ * every kernel returns exactly the same counters and leaves the lanes in
+ * exactly the same state.
+ *
+ * @param rounds Number of rounds to play.
+ * @param kernel Batch kernel to use.
+ * @param rng Pointer to the lanes to draw from.
+ * @param result Pointer to the counters to increment (series counters are left untouched).
+ */
+void simulateRounds(long long rounds, const BatchKernel *kernel, BatchRng *rng, SimulationResult *result);
+
+/**
+ * @brief Plays a simulation job and returns the elapsed wall-clock seconds.
+ *
+ * The series (or rounds) are split as evenly as possible across
+ * job->threads workers. Worker i draws from stream i of the seed, so a run
+ * is reproducible for a given seed and thread count. Series are played by
+ * simulateSeries when both strategies are random, by
+ * simulateStrategySeries (each worker with its own strategy state)
+ * otherwise; batch rounds are always random.
+ *
+ * @param job Pointer to the work to do.
+ * @param result Pointer to the counters to increment.
+ * @return The elapsed seconds, or a negative value if a worker could not be started.
+ */
+double runSimulationJob(const SimulationJob *job, SimulationResult *result);
+
+#endif
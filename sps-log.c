@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-log.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Binary match log: buffered append-only writer and match reader.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <string.h>    // String manipulation functions (strlen, memcpy, memcmp)
+# include <errno.h> // Error numbers (EINTR)
+# include <unistd.h>    // POSIX operating system API (write, close)
+# include <fcntl.h> // POSIX file control (open)
+# include "sps-engine.h"    // MAX_PLAYER_NAME
+# include "sps-log.h"   // Match log types and prototypes
+
+int matchLogOpen(MatchLog *log, const char *path) {
+
+    log->descriptor = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    log->inMatch = 0;
+    log->failed = 0;
+    log->length = 0;
+
+    return (log->descriptor < 0) ? -1 : 0;}
+
+/**
+ * @brief Writes the whole buffer to the log file.
+ */
+static void matchLogFlush(MatchLog *log) {
+
+    const uint8_t *data = log->buffer;
+    size_t length = log->length;
+
+    while ((length > 0) && !log->failed) {
+
+        ssize_t written = write(log->descriptor, data, length);
+
+        if (written < 0) {
+            if (errno != EINTR)
+                log->failed = 1;
+
+            continue;}
+
+        data += written;
+        length -= (size_t) written;}
+
+    log->length = 0;}
+
+/**
+ * @brief Buffers bytes, writing the buffer out first if they do not fit.
+ */
+static void matchLogPut(MatchLog *log, const void *data, size_t length) {
+
+    if (log->length + length > MATCH_LOG_BUFFER_SIZE)
+        matchLogFlush(log);
+
+    memcpy(log->buffer + log->length, data, length);
+    log->length += length;}
+
+/**
+ * @brief Stores an unsigned integer as little-endian bytes.
+ */
+static void storeLittleEndian(uint8_t *destination, uint64_t value, int bytes) {
+
+    for (int i = 0; i < bytes; i++)
+        destination[i] = (uint8_t) (value >> (8 * i));}
+
+/**
+ * @brief Reads little-endian bytes as an unsigned integer.
+ */
+static uint64_t loadLittleEndian(const uint8_t *source, int bytes) {
+
+    uint64_t value = 0;
+
+    for (int i = 0; i < bytes; i++)
+        value |= (uint64_t) source[i] << (8 * i);
+
+    return value;}
+
+void matchLogBegin(MatchLog *log, uint64_t seed, int bestOf, const char *name) {
+
+    uint8_t header[MATCH_LOG_HEADER_SIZE + MAX_PLAYER_NAME];
+    size_t nameLength = strlen(name);
+
+    if (nameLength > MAX_PLAYER_NAME - 1)
+        nameLength = MAX_PLAYER_NAME - 1;
+
+    memcpy(header, MATCH_LOG_MAGIC, MATCH_LOG_MAGIC_LENGTH);
+    storeLittleEndian(header + 4, seed, 8);
+    storeLittleEndian(header + 12, (uint32_t) bestOf, 4);
+    header[16] = (uint8_t) nameLength;
+    memcpy(header + MATCH_LOG_HEADER_SIZE, name, nameLength);
+
+    matchLogPut(log, header, MATCH_LOG_HEADER_SIZE + nameLength);
+    log->inMatch = 1;}
+
+void matchLogRound(MatchLog *log, int playerChoice, int computerChoice, int outcome) {
+
+    if (log->length == MATCH_LOG_BUFFER_SIZE)
+        matchLogFlush(log);
+
+    log->buffer[log->length++] = (uint8_t) (playerChoice | (computerChoice << 2) | (outcome << 4));}
+
+void matchLogEnd(MatchLog *log, int decided) {
+
+    uint8_t end = decided ? MATCH_LOG_DECIDED : MATCH_LOG_ABANDONED;
+
+    matchLogPut(log, &end, 1);
+    log->inMatch = 0;}
+
+int matchLogClose(MatchLog *log) {
+
+    if (log->inMatch)
+        matchLogEnd(log, 0);
+
+    matchLogFlush(log);
+
+    if (close(log->descriptor) != 0)
+        log->failed = 1;
+
+    return log->failed ? -1 : 0;}
+
+size_t matchLogParse(const uint8_t *data, size_t size, MatchLogRecord *record) {
+
+    if ((size < MATCH_LOG_HEADER_SIZE) || (memcmp(data, MATCH_LOG_MAGIC, MATCH_LOG_MAGIC_LENGTH) != 0))
+        return 0;
+
+    record->seed = loadLittleEndian(data + 4, 8);
+    record->bestOf = (uint32_t) loadLittleEndian(data + 12, 4);
+    record->nameLength = data[16];
+    record->name = (const char *) data + MATCH_LOG_HEADER_SIZE;
+
+    size_t offset = MATCH_LOG_HEADER_SIZE + record->nameLength;
+
+    if (offset > size)
+        return 0;
+
+    // Round bytes have a choice in their low two bits; the end byte does not.
+    record->rounds = data + offset;
+
+    while ((offset < size) && ((data[offset] & 3) != 0))
+        offset++;
+
+    if ((offset == size) || ((data[offset] != MATCH_LOG_DECIDED) && (data[offset] != MATCH_LOG_ABANDONED)))
+        return 0;
+
+    record->roundCount = (size_t) ((data + offset) - record->rounds);
+    record->decided = (data[offset] == MATCH_LOG_DECIDED);
+
+    return offset + 1;}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-log.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Binary match log ('--log'): an append-only file of matches,
+ * one byte per round, written through a large buffer, and the reader used
+ * by the sps-stats analyzer.
+ *
+ * A match is a header followed by its rounds and an end byte:
+ *
+ *   "SPSL"             4 bytes, MATCH_LOG_MAGIC
+ *   seed               8 bytes, little-endian seed of the run the match was played in
+ *   bestOf             4 bytes, little-endian 'Best-of' length
+ *   name length        1 byte, at most MAX_PLAYER_NAME - 1
+ *   name               the player's name, not null-terminated
+ *   rounds             1 byte each: player choice | computer choice << 2 | outcome << 4
+ *   end                MATCH_LOG_DECIDED, or MATCH_LOG_ABANDONED if the match stopped early
+ *
+ * Choices are 1 to 3, so the low two bits of a round byte are never 0 and
+ * the end byte cannot be mistaken for a round.
+ */
+
+#ifndef SPS_LOG_H
+#define SPS_LOG_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint8_t, uint64_t)
+
+// Define constants for the match log
+#define MATCH_LOG_MAGIC "SPSL"  // First bytes of every match header.
+#define MATCH_LOG_MAGIC_LENGTH 4    // Length of MATCH_LOG_MAGIC.
+#define MATCH_LOG_HEADER_SIZE 17    // Header bytes before the name.
+#define MATCH_LOG_DECIDED 0x00  // End byte of a match one side won.
+#define MATCH_LOG_ABANDONED 0x04    // End byte of a match that stopped before it was decided.
+#define MATCH_LOG_BUFFER_SIZE (1 << 20) // Bytes buffered before the log is written out.
+
+// Data types
+/**
+ * @brief Buffered, append-only writer of a match log.
+ */
+typedef struct {
+    int descriptor;     // Log file, opened for appending
+    int inMatch;        // Non-zero between matchLogBegin and matchLogEnd
+    int failed;         // Non-zero once a write has failed
+    size_t length;      // Bytes in buffer
+    uint8_t buffer[MATCH_LOG_BUFFER_SIZE];
+} MatchLog;
+
+/**
+ * @brief Header of a match, as read back by matchLogParse.
+ */
+typedef struct {
+    uint64_t seed;          // Seed of the run the match was played in
+    uint32_t bestOf;        // 'Best-of' length
+    const char *name;       // Player's name inside the log data (not null-terminated)
+    size_t nameLength;      // Bytes of name
+    const uint8_t *rounds;  // First round byte
+    size_t roundCount;      // Round bytes before the end byte
+    int decided;            // Non-zero if the end byte is MATCH_LOG_DECIDED
+} MatchLogRecord;
+
+// Function prototypes
+/**
+ * @brief Opens a match log for appending, creating it if needed.
+ *
+ * @param log Pointer to the writer.
+ * @param path Log file.
+ * @return 0 on success, -1 if the file could not be opened.
+ */
+int matchLogOpen(MatchLog *log, const char *path);
+
+/**
+ * @brief Starts a match: buffers its header.
+ *
+ * @param log Pointer to the writer.
+ * @param seed Seed of the run.
+ * @param bestOf 'Best-of' length of the match.
+ * @param name Player's name (truncated to MAX_PLAYER_NAME - 1 bytes).
+ */
+void matchLogBegin(MatchLog *log, uint64_t seed, int bestOf, const char *name);
+
+/**
+ * @brief Records one round of the current match.
+ *
+ * @param log Pointer to the writer.
+ * @param playerChoice Player's choice (1 to 3).
+ * @param computerChoice Computer's choice (1 to 3).
+ * @param outcome ROUND_TIE, ROUND_PLAYER_WINS or ROUND_COMPUTER_WINS.
+ */
+void matchLogRound(MatchLog *log, int playerChoice, int computerChoice, int outcome);
+
+/**
+ * @brief Ends the current match.
+ *
+ * @param log Pointer to the writer.
+ * @param decided Non-zero if one side won the match, 0 if it was abandoned.
+ */
+void matchLogEnd(MatchLog *log, int decided);
+
+/**
+ * @brief Ends a match still in progress as abandoned, writes out the buffer and closes the log.
+ *
+ * @param log Pointer to the writer.
+ * @return 0 on success, -1 if any write to the log failed.
+ */
+int matchLogClose(MatchLog *log);
+
+/**
+ * @brief Parses the match starting at the beginning of some log data.
+ *
+ * @param data Log data (e.g. a mapped log file) positioned on a match header.
+ * @param size Bytes of data.
+ * @param record Filled in with the match.
+ * @return Bytes the match takes, end byte included, or 0 if the data does not start with a complete match.
+ */
+size_t matchLogParse(const uint8_t *data, size_t size, MatchLogRecord *record);
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-metrics.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Per-phase latency histograms and their report.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (snprintf)
+# include "sps-metrics.h"  // Metrics types and prototypes
+
+// Define constants for the report
+#define METRICS_VALUE_BUFFER 16 // Longest formatted duration (e.g. "999.9 ms").
+
+int metricsActive;
+
+// Histogram of every phase, indexed by MetricPhase; each thread has its own.
+static _Thread_local MetricHistogram histograms[METRIC_COUNT];
+
+// Name of every phase in the report, indexed by MetricPhase.
+static const char *const phaseNames[METRIC_COUNT] = {"think", "render", "sleep", "output", "banner", "server_event"};
+
+void metricsEnable(void) {
+
+    metricsActive = 1;}
+
+void metricsRecord(MetricPhase phase, uint64_t nanoseconds) {
+
+    MetricHistogram *histogram = &histograms[phase];
+
+    // The highest set bit picks the power of two, the next METRICS_SUB_BITS bits the bucket within it.
+    unsigned magnitude = 63u - (unsigned) __builtin_clzll(nanoseconds | (1u << METRICS_SUB_BITS));
+    unsigned shift = magnitude - METRICS_SUB_BITS;
+
+    histogram->buckets[(shift << METRICS_SUB_BITS) + (unsigned) (nanoseconds >> shift)]++;
+    histogram->count++;
+    histogram->total += nanoseconds;
+    histogram->max = (nanoseconds > histogram->max) ? nanoseconds : histogram->max;}
+
+/**
+ * @brief Returns the highest value that falls in a bucket.
+ */
+static uint64_t metricsBucketHighest(unsigned bucket) {
+
+    if (bucket < (2u << METRICS_SUB_BITS))
+        return bucket;
+
+    unsigned shift = (bucket >> METRICS_SUB_BITS) - 1;
+    uint64_t lowest = (uint64_t) (bucket - (shift << METRICS_SUB_BITS)) << shift;
+
+    return lowest + ((UINT64_C(1) << shift) - 1);}
+
+uint64_t metricsPercentile(MetricPhase phase, int percent) {
+
+    const MetricHistogram *histogram = &histograms[phase];
+    uint64_t rank = (histogram->count * (uint64_t) percent + 99) / 100;   // Nearest rank
+    uint64_t seen = 0;
+
+    if (rank == 0)
+        rank = 1;
+
+    for (unsigned bucket = 0; bucket < METRICS_BUCKETS; bucket++) {
+        seen += histogram->buckets[bucket];
+
+        if (seen >= rank) {
+            uint64_t highest = metricsBucketHighest(bucket);
+            return (highest < histogram->max) ? highest : histogram->max;}}
+
+    return 0;}
+
+/**
+ * @brief Formats a duration in the unit that keeps it between 1 and 1000.
+ */
+static void metricsFormatValue(char *buffer, size_t size, uint64_t nanoseconds) {
+
+    if (nanoseconds < 1000)
+        snprintf(buffer, size, "%llu ns", (unsigned long long) nanoseconds);
+
+    else if (nanoseconds < 1000000)
+        snprintf(buffer, size, "%.1f us", (double) nanoseconds / 1e3);
+
+    else if (nanoseconds < 1000000000)
+        snprintf(buffer, size, "%.1f ms", (double) nanoseconds / 1e6);
+
+    else
+        snprintf(buffer, size, "%.2f s", (double) nanoseconds / 1e9);}
+
+size_t metricsFormat(char *buffer, size_t size) {
+
+    size_t used = 0;
+    int written = snprintf(buffer, size, "%-13s %10s %10s %10s %10s %10s %10s\n", "Phase", "Count", "p50", "p90", "p99", "Max", "Total");
+
+    used += (written > 0) ? (size_t) written : 0;
+
+    for (int phase = 0; (phase < METRIC_COUNT) && (used < size); phase++) {
+
+        const MetricHistogram *histogram = &histograms[phase];
+        static const int percents[3] = {50, 90, 99};
+        char values[5][METRICS_VALUE_BUFFER];
+
+        if (histogram->count == 0)
+            continue;
+
+        for (int i = 0; i < 3; i++)
+            metricsFormatValue(values[i], sizeof values[i], metricsPercentile((MetricPhase) phase, percents[i]));
+
+        metricsFormatValue(values[3], sizeof values[3], histogram->max);
+        metricsFormatValue(values[4], sizeof values[4], histogram->total);
+
+        written = snprintf(buffer + used, size - used, "%-13s %10llu %10s %10s %10s %10s %10s\n", phaseNames[phase], (unsigned long long) histogram->count,
+            values[0], values[1], values[2], values[3], values[4]);
+        used += (written > 0) ? (size_t) written : 0;}
+
+    return (used < size) ? used : size - 1;}
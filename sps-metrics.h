@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-metrics.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Hot-path instrumentation: a latency histogram per phase of
+ * the game (player think time, rendering, animation sleeps, output writes,
+ * banners and server events), dumped by '--stats' and served by the server
+ * on its '/metrics' line.
+ *
+ * Histograms have fixed log-linear buckets, as in HdrHistogram: values
+ * below 2^(METRICS_SUB_BITS + 1) nanoseconds get a bucket each, and every
+ * power of two above is split into 2^METRICS_SUB_BITS buckets, so any value
+ * is known to within 1/2^METRICS_SUB_BITS (about 6%). Recording a value is
+ * a count-leading-zeros, a shift and three additions, with no allocation
+ * and no lock: the histograms are thread-local, so the game and every
+ * server loop record into (and report) their own.
+ */
+
+#ifndef SPS_METRICS_H
+#define SPS_METRICS_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint64_t)
+# include <time.h>  // Time functions (clock_gettime)
+
+// Define constants for the histograms
+#define METRICS_SUB_BITS 4  // Each power of two is split into 2^METRICS_SUB_BITS buckets.
+#define METRICS_BUCKETS ((64 - METRICS_SUB_BITS + 1) << METRICS_SUB_BITS)  // Buckets covering every 64-bit value.
+
+// Data types
+/**
+ * @brief Phases timed by the instrumentation.
+ */
+typedef enum {
+    METRIC_THINK = 0,       // Waiting for the player's input
+    METRIC_RENDER,          // Queueing a round frame (asciiArtPrinter)
+    METRIC_SLEEP,           // Animation pauses actually waited
+    METRIC_OUTPUT,          // write() of the game's output buffer
+    METRIC_BANNER,          // Final banner: built-in renderer, or figlet's fork to waitpid
+    METRIC_SERVER_EVENT,    // Handling one event of the server loop
+    METRIC_COUNT
+} MetricPhase;
+
+/**
+ * @brief Latency histogram of one phase, in nanoseconds.
+ */
+typedef struct {
+    uint64_t count;                     // Values recorded
+    uint64_t total;                     // Sum of the values
+    uint64_t max;                       // Largest value
+    uint64_t buckets[METRICS_BUCKETS];  // Values recorded per bucket
+} MetricHistogram;
+
+// Non-zero once metricsEnable has been called; phases are not timed before.
+extern int metricsActive;
+
+// Function prototypes
+/**
+ * @brief Starts timing every phase.
+ */
+void metricsEnable(void);
+
+/**
+ * @brief Records one value of a phase.
+ *
+ * @param phase Phase the value belongs to.
+ * @param nanoseconds Duration to record.
+ */
+void metricsRecord(MetricPhase phase, uint64_t nanoseconds);
+
+/**
+ * @brief Returns a percentile of a phase: the highest value of the bucket holding it, capped at the largest value.
+ *
+ * @param phase Phase to read.
+ * @param percent Percentile (0 to 100).
+ * @return The percentile in nanoseconds, or 0 if nothing was recorded.
+ */
+uint64_t metricsPercentile(MetricPhase phase, int percent);
+
+/**
+ * @brief Formats a table of every phase recorded: count, p50, p90, p99, maximum and total.
+ *
+ * @param buffer Destination buffer (truncated if too small; 1 KiB is enough).
+ * @param size Size of the buffer.
+ * @return Length of the table, without the null terminator (at most size - 1).
+ */
+size_t metricsFormat(char *buffer, size_t size);
+
+/**
+ * @brief Returns the monotonic clock in nanoseconds.
+ */
+static inline uint64_t metricsNow(void) {
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;}
+
+/**
+ * @brief Starts timing a phase: returns the current time, or 0 if metrics are off.
+ */
+static inline uint64_t metricsStart(void) {
+
+    return metricsActive ? metricsNow() : 0;}
+
+/**
+ * @brief Ends timing a phase started with metricsStart (nothing is recorded if it returned 0).
+ */
+static inline void metricsStop(MetricPhase phase, uint64_t start) {
+
+    if (start != 0)
+        metricsRecord(phase, metricsNow() - start);}
+
+#endif
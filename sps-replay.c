@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-replay.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Scripted games ('--moves'): plays the player's moves from a
+ * memory-mapped file against the computer at full speed, writing a compact
+ * outcome log instead of the art and animations.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (fprintf, snprintf, perror)
+# include <string.h>    // String manipulation functions (memset, memcmp)
+# include <unistd.h>    // POSIX operating system API (close)
+# include <fcntl.h> // POSIX file control (open)
+# include <sys/mman.h>  // POSIX memory mapping (mmap, madvise) for the move file
+# include <sys/stat.h>  // POSIX file status (fstat) for sizing the mapping
+# include "sps-engine.h"    // Round resolution, choices and random numbers
+# include "sps-terminal.h"  // Output buffer
+# include "sps-replay.h"    // Replay types and prototypes
+
+// Data types
+/**
+ * @brief The series being replayed.
+ */
+typedef struct {
+    ReplayResult *result;   // Counters of the whole file
+    MatchLog *log;          // Match log, or NULL
+    Strategy computer;      // Computer's strategy, learning across series
+    uint64_t seed;          // Seed recorded in the match log
+    int bestOf;             // 'Best-of' length of a series
+    int winsNeeded;         // Wins required to win a series
+    int playerWins;         // Rounds won by the player in this series
+    int computerWins;       // Rounds won by the computer in this series
+    int started;            // Non-zero once the series has a round
+} ReplayGame;
+
+/**
+ * @brief Plays one valid move against the computer and logs the round (and the series once decided).
+ */
+static void replayPlay(ReplayGame *game, int playerChoice) {
+
+    ReplayResult *result = game->result;
+    int computerChoice = strategyChoose(&game->computer, rngDefault());
+    int outcome = resolveRound(playerChoice, computerChoice);
+
+    strategyObserve(&game->computer, playerChoice);
+
+    if (!game->started) {
+        char number[32];
+        int length = snprintf(number, sizeof number, "%lld:", result->series + 1);
+
+        outputWrite(number, (size_t) length);
+        game->started = 1;
+
+        if (game->log != NULL)
+            matchLogBegin(game->log, game->seed, game->bestOf, "Player");}
+
+    // Outcome letters indexed by ROUND_TIE, ROUND_PLAYER_WINS and ROUND_COMPUTER_WINS.
+    char token[4] = {' ', (char) ('0' + playerChoice), (char) ('0' + computerChoice), "TWL"[outcome]};
+
+    outputWrite(token, sizeof token);
+
+    if (game->log != NULL)
+        matchLogRound(game->log, playerChoice, computerChoice, outcome);
+
+    result->moves++;
+    result->ties += (outcome == ROUND_TIE);
+    result->playerRounds += (outcome == ROUND_PLAYER_WINS);
+    result->computerRounds += (outcome == ROUND_COMPUTER_WINS);
+    game->playerWins += (outcome == ROUND_PLAYER_WINS);
+    game->computerWins += (outcome == ROUND_COMPUTER_WINS);
+
+    if ((game->playerWins != game->winsNeeded) && (game->computerWins != game->winsNeeded))
+        return;
+
+    char score[64];
+    int playerWon = (game->playerWins == game->winsNeeded);
+    int length = snprintf(score, sizeof score, " | %i:%i %s\n", game->playerWins, game->computerWins, playerWon ? "Player" : "Computer");
+
+    outputWrite(score, (size_t) length);
+
+    if (game->log != NULL)
+        matchLogEnd(game->log, 1);
+
+    result->series++;
+    result->playerSeries += playerWon;
+    result->computerSeries += !playerWon;
+    game->playerWins = 0;
+    game->computerWins = 0;
+    game->started = 0;}
+
+/**
+ * @brief Handles one line of a text move file as returned by the tokenizer; returns 1 if the replay must stop.
+ */
+static int replayTextLine(ReplayGame *game, int choice, const char *path, long long line) {
+
+    if (choice > 0) {
+        replayPlay(game, choice);
+        return 0;}
+
+    game->result->invalidLines++;
+
+    if (choice == CHOICE_EXHAUSTED) {
+        outputFlush();
+        fprintf(stderr, "Too many invalid inputs in '%s' (line %lld)...\n", path, line);
+        return 1;}
+
+    return 0;}
+
+/**
+ * @brief Plays a text move file, one choice per line; returns 1 if it had too many invalid lines in a row.
+ */
+static int replayText(ReplayGame *game, const char *data, size_t size, const char *path) {
+
+    ChoiceTokenizer tokenizer;
+    long long line = 0;
+
+    choiceTokenizerInit(&tokenizer);
+
+    for (size_t used = 0; used < size; ) {
+
+        int choice;
+
+        used += choiceTokenizerFeed(&tokenizer, data + used, size - used, &choice);
+
+        if ((choice != CHOICE_PENDING) && (replayTextLine(game, choice, path, ++line) != 0))
+            return 1;}
+
+    // A last line without a newline still counts, as at the end of interactive input.
+    if (tokenizer.length > 0)
+        return replayTextLine(game, choiceTokenizerEndLine(&tokenizer), path, ++line);
+
+    return 0;}
+
+/**
+ * @brief Plays the 2-bit codes of a packed move file (after the magic) until a 0 code or the end.
+ */
+static void replayPacked(ReplayGame *game, const unsigned char *data, size_t size) {
+
+    for (size_t i = 0; i < size; i++)
+        for (int shift = 0; shift < 8; shift += 2) {
+
+            int choice = (data[i] >> shift) & 3;
+
+            if (choice == 0)
+                return;
+
+            replayPlay(game, choice);}}
+
+int replayMoves(const char *path, int bestOf, const StrategySpec *strategy, MatchLog *log, uint64_t seed, ReplayResult *result) {
+
+    memset(result, 0, sizeof *result);
+
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+
+    if ((fd < 0) || (fstat(fd, &info) != 0)) {
+        perror("Could not open the move file");
+
+        if (fd >= 0)
+            close(fd);
+
+        return 1;}
+
+    size_t size = (size_t) info.st_size;
+    const char *data = (size > 0) ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        perror("Could not map the move file");
+        return 1;}
+
+    if (size > 0)
+        madvise((void *) data, size, MADV_SEQUENTIAL);  // Read once, front to back
+
+    static ReplayGame game;     // Static: the strategy tables are too large to want on the stack
+    int status = 0;
+
+    game = (ReplayGame) {.result = result, .log = log, .seed = seed, .bestOf = bestOf, .winsNeeded = (bestOf + 1) / 2};
+    strategyInit(&game.computer, strategy);
+
+    result->packed = (size >= REPLAY_PACKED_MAGIC_LENGTH) && (memcmp(data, REPLAY_PACKED_MAGIC, REPLAY_PACKED_MAGIC_LENGTH) == 0);
+
+    if (result->packed)
+        replayPacked(&game, (const unsigned char *) data + REPLAY_PACKED_MAGIC_LENGTH, size - REPLAY_PACKED_MAGIC_LENGTH);
+
+    else
+        status = replayText(&game, data, size, path);
+
+    // The moves ran out in the middle of a series.
+    if ((status == 0) && game.started) {
+        char score[64];
+        int length = snprintf(score, sizeof score, " | %i:%i unfinished\n", game.playerWins, game.computerWins);
+
+        outputWrite(score, (size_t) length);
+        result->unfinished = 1;
+
+        if (log != NULL)
+            matchLogEnd(log, 0);}
+
+    outputFlush();
+
+    if (size > 0)
+        munmap((void *) data, size);
+
+    return status;}
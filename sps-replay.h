@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-replay.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Scripted games ('--moves'): plays the player's moves from a
+ * memory-mapped file against the computer at full speed, writing a compact
+ * outcome log instead of the art and animations.
+ */
+
+#ifndef SPS_REPLAY_H
+#define SPS_REPLAY_H
+
+# include <stdint.h>    // Fixed-width integer types (uint64_t) for the seed
+# include "sps-engine.h"    // Computer strategies
+# include "sps-log.h"   // Match log writer
+
+// Define constants for move files
+#define REPLAY_PACKED_MAGIC "SPSM"  // First bytes of a packed move file.
+#define REPLAY_PACKED_MAGIC_LENGTH 4    // Length of REPLAY_PACKED_MAGIC.
+
+// Data types
+/**
+ * @brief Counters of a replayed move file.
+ */
+typedef struct {
+    long long moves;            // Valid moves played
+    long long invalidLines;     // Lines of a text file that were not a choice
+    long long series;           // Series completed
+    long long playerSeries;     // Series won by the player
+    long long computerSeries;   // Series won by the computer
+    long long playerRounds;     // Rounds won by the player
+    long long computerRounds;   // Rounds won by the computer
+    long long ties;             // Tied rounds
+    int unfinished;             // Non-zero if the last series ran out of moves before it was decided
+    int packed;                 // Non-zero if the file was in the packed format
+} ReplayResult;
+
+// Function prototypes
+/**
+ * @brief Plays every move of a move file, series after series, and writes the outcome log.
+ *
+ * A text file holds one choice per line, validated exactly like the
+ * interactive prompt: case-insensitive, an over-long line is cut to the
+ * prompt's buffer, and MAX_CHOICE_ATTEMPTS invalid lines in a row stop the
+ * replay. A packed file starts with REPLAY_PACKED_MAGIC, followed by the
+ * moves at 2 bits each (1 Stone, 2 Paper, 3 Scissors), four per byte from
+ * the low bits up; a 0 code ends the moves.
+ *
+ * The log, written to the game's output buffer, has one line per series:
+ * its number, then a "<player><computer><outcome>" token per round (the
+ * choices as digits, the outcome as W, L or T for the player), then the
+ * final score and the winner.
+ *
+ * @param path Move file to map.
+ * @param bestOf 'Best-of' length of every series (positive odd integer).
+ * @param strategy Computer's strategy; it keeps learning from one series to the next.
+ * @param log Match log each series is also recorded in, or NULL.
+ * @param seed Seed of the run, recorded in the match log headers.
+ * @param result Counters to fill in.
+ * @return 0 on success, 1 if the file could not be read or had too many invalid lines in a row.
+ */
+int replayMoves(const char *path, int bestOf, const StrategySpec *strategy, MatchLog *log, uint64_t seed, ReplayResult *result);
+
+#endif
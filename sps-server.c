@@ -0,0 +1,1488 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-server.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Network game server ('--serve'). A single thread multiplexes
+ * every connection with epoll (Linux) or kqueue (BSD, macOS); each
+ * connection owns a small session from the session pool, which replaces the
+ * stack locals of the interactive game. The output of a session is gathered
+ * as a list of parts and handed to the socket with one writev: text is
+ * copied into a scratch buffer, while the round frames are referenced in
+ * their shared read-only region, so the art is never copied per connection.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (printf, snprintf, perror)
+# include <stdlib.h>    // Standard library functions (calloc, free, strtol)
+# include <stdint.h>    // Fixed-width integer types (uint32_t, uintptr_t)
+# include <string.h>    // String manipulation functions (memcpy, memmove, strspn, strstr)
+# include <ctype.h> // Character handling (tolower) for HTTP headers
+# include <errno.h> // Error numbers (EINTR, EAGAIN, ERANGE)
+# include <limits.h>    // Integer limits (INT_MIN, INT_MAX)
+# include <signal.h>    // Signal handling (signal, sigaction) for SIGPIPE and SIGUSR1
+# include <unistd.h>    // POSIX operating system API (close)
+# include <fcntl.h> // POSIX file control (fcntl) for non-blocking sockets
+# include <sys/socket.h>    // Sockets (socket, bind, listen, accept, recv, shutdown)
+# include <sys/uio.h>   // Scatter/gather I/O (writev, struct iovec)
+# include <pthread.h>   // POSIX threads (pthread_create) for the event loops
+# include <netinet/in.h>    // Internet addresses (sockaddr_in, INADDR_ANY)
+#if defined(__linux__)
+# include <sys/epoll.h> // Linux event notification (epoll_create1, epoll_ctl, epoll_wait)
+#else
+# include <sys/event.h> // BSD and macOS event notification (kqueue, kevent)
+#endif
+# include "sps-engine.h"    // Round resolution, choices and random numbers
+# include "sps-banner.h"    // Built-in figlet font renderer
+# include "sps-banner-cache.h" // Rendered result banners
+# include "sps-deflate.h"   // Precompressed frames and banners for MCCP2 sessions
+# include "sps-websocket.h" // Browser sessions
+# include "sps-metrics.h"   // Phase timing served on '/metrics'
+# include "sps-session.h"   // Session and output block pools
+# include "sps-checkpoint.h"    // Series in progress kept across disconnects and restarts
+# include "sps-server.h"    // Server types and prototypes
+
+// Define constants for the server
+#define SERVER_LISTEN_BACKLOG 1024  // Pending connections queued by the kernel.
+#define SERVER_MAX_EVENTS 256   // Events handled per wait of the event loop.
+#define SERVER_RECEIVE_CHUNK 256    // Bytes read from a connection at a time.
+#define SERVER_SCRATCH_SIZE 65536   // Text output of the session being handled, sent before anything is queued.
+#define SERVER_MAX_PARTS 64 // Parts (text runs and frames) gathered into one writev.
+#define SERVER_METRICS_LINE "/metrics"  // Name line that asks for the server's counters instead of a game.
+#define SERVER_RESUME_LINE "/resume "   // Start of a name line that continues a checkpointed series: its code follows.
+#define SERVER_STATS_BUFFER 4096    // Text of the counters served on SERVER_METRICS_LINE.
+#define SERVER_CHECKPOINT_RECORDS 16384 // Records of a new checkpoint file (64 MiB, sparse): the series in progress at once.
+#define SERVER_BANNER_CACHE_BYTES (4 << 20) // Memory the banner cache of each loop may hold (a few thousand banners).
+#define SERVER_NO_OFFSET SIZE_MAX   // Offset in scratch of the stored block or WebSocket message being extended when none is open.
+#define SERVER_WEB_LISTENER (SESSION_NONE - 1)  // Event index of the browser port's listening socket.
+
+// Define constants for the browser gateway (HTTP/1.1 and WebSocket)
+#define WEB_REQUEST_LINE "GET / "   // Start of the only request served; other paths get a 404.
+#define WEB_REQUEST_LINE_LENGTH 6   // Length of WEB_REQUEST_LINE.
+#define WEB_KEY_HEADER "sec-websocket-key:" // Header of a WebSocket handshake, matched case-insensitively.
+#define WEB_KEY_HEADER_LENGTH 18    // Length of WEB_KEY_HEADER.
+#define WEB_FRAMES_MARKER "@FRAMES@"    // Where the client page takes the frames.
+#define WEB_NOT_FOUND "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+#define WEB_UPGRADE "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: "
+
+
+// Define constants for the telnet protocol (RFC 854) and MCCP2
+#define TELNET_IAC 255      // 'Interpret as command': starts every command.
+#define TELNET_DONT 254     // Refuses an option the other side offered.
+#define TELNET_DO 253       // Accepts an option the other side offered.
+#define TELNET_WILL 251     // Offers an option (also 252, WONT, refuses one).
+#define TELNET_SB 250       // Starts a subnegotiation, up to IAC SE.
+#define TELNET_SE 240       // Ends a subnegotiation.
+#define TELNET_COMPRESS2 86 // MCCP2: the server's output becomes a zlib stream.
+#define TELNET_OFFER_COMPRESS2 "\xff\xfb\x56"  // IAC WILL COMPRESS2
+#define TELNET_START_COMPRESS2 "\xff\xfa\x56\xff\xf0"  // IAC SB COMPRESS2 IAC SE: everything after it is compressed.
+
+// Several loops need a kernel that balances connections over SO_REUSEPORT sockets (Linux 3.9 and later).
+#if defined(__linux__) && defined(SO_REUSEPORT)
+#define SERVER_REUSEPORT 1
+#else
+#define SERVER_REUSEPORT 0
+#endif
+
+// Data types
+/**
+ * @brief Where the telnet filter of a session is in a command.
+ */
+typedef enum {
+    TELNET_TEXT = 0,        // Passing input through
+    TELNET_COMMAND,         // After IAC
+    TELNET_OPTION,          // After WILL, WONT or DONT: the option is ignored
+    TELNET_OPTION_DO,       // After DO: the option the client accepts
+    TELNET_SUBNEGOTIATION,  // Inside SB, skipped
+    TELNET_SUBNEGOTIATION_IAC   // After IAC inside SB
+} TelnetState;
+
+/**
+ * @brief A round frame deflated once for every MCCP2 session.
+ */
+typedef struct {
+    uint8_t *data;  // Deflate blocks of the frame's text
+    size_t length;  // Bytes of data
+} CompressedFrame;
+
+/**
+ * @brief Read-only data built once by serverRun and shared by every loop.
+ */
+typedef struct {
+    const BannerFont *font;             // Font of the final banner (NULL if none could be loaded)
+    CompressedFrame compressedFrames[3][3]; // Deflated round frames (only with compression)
+    char *page;                         // HTTP response carrying the browser client (only with a browser port)
+    size_t pageLength;                  // Bytes of page
+    CheckpointFile *checkpoint;         // Series in progress, written by every loop to its own records (only with a checkpoint file)
+} ServerAssets;
+
+/**
+ * @brief State of one event loop; loops share nothing but the configuration, the frames and the assets, which they only read.
+ */
+typedef struct {
+    const ServerConfig *config;     // Configuration passed to serverRun
+    unsigned loop;                  // Index of the loop (0 runs on the thread that called serverRun)
+    sig_atomic_t statsSeen;         // Value of serverStatsGeneration when the counters were last printed
+    const ServerAssets *assets;     // Font, deflated frames and client page
+    BannerCache banners;            // Final banners rendered by this loop, by name, scores and width
+    BannerCache deflatedBanners;    // The same banners deflated, for MCCP2 sessions
+    long long compressedSessions;   // Sessions that accepted MCCP2
+    long long pagesServed;          // Browser client pages sent
+    long long webSessions;          // WebSocket handshakes completed
+    long long resumedSeries;        // Checkpointed series resumed with their code
+    uint32_t checkpointCursor;      // Record this loop's next claim starts at (the loop owns every record i with i % threads == loop)
+    CheckpointBatch checkpoints;    // Records changed since the last batch of events
+    int poller;                     // epoll or kqueue descriptor
+    int listener;                   // Listening socket
+    int webListener;                // Listening socket of the browser port, or -1
+    SessionPool sessions;           // Game state of every connection
+    OutputBlockPool output;         // Output the sockets have not accepted yet
+    int partCount;                  // Parts of output gathered for the current session
+    struct iovec parts[SERVER_MAX_PARTS];   // Output in order: runs of scratch, or shared frames
+    uint8_t partShared[SERVER_MAX_PARTS];   // Non-zero for parts in shared memory rather than scratch
+    size_t scratchLength;           // Bytes in scratch
+    size_t storedBlock;             // Offset in scratch of the stored block text can still be added to, or SERVER_NO_OFFSET
+    size_t textMessage;             // Offset in scratch of the WebSocket text message being written, or SERVER_NO_OFFSET
+    char scratch[SERVER_SCRATCH_SIZE];  // Text output produced while handling the current session
+} Server;
+
+/**
+ * @brief One readiness notification from the event loop.
+ */
+typedef struct {
+    uint32_t session;   // Index of the session, SESSION_NONE for the listening socket or SERVER_WEB_LISTENER
+    int writable;       // Non-zero if the socket can take more output (otherwise it is readable)
+} ServerEvent;
+
+// Incremented by SIGUSR1: every loop that sees a new value prints its counters.
+static volatile sig_atomic_t serverStatsGeneration;
+
+#if defined(__linux__)
+
+/**
+ * @brief Creates the event loop's epoll instance.
+ */
+static int pollerCreate(void) {
+
+    return epoll_create1(0);}
+
+/**
+ * @brief Watches a socket for input, or only for room to write output.
+ */
+static int pollerWatch(int poller, int descriptor, uint32_t session, int writable, int add) {
+
+    struct epoll_event event = {.events = writable ? EPOLLOUT : EPOLLIN, .data.u32 = session};
+
+    return epoll_ctl(poller, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, descriptor, &event);}
+
+/**
+ * @brief Waits for readiness notifications; returns their number or -1.
+ */
+static int pollerWait(int poller, ServerEvent *events, int capacity) {
+
+    struct epoll_event ready[SERVER_MAX_EVENTS];
+    int count = epoll_wait(poller, ready, (capacity < SERVER_MAX_EVENTS) ? capacity : SERVER_MAX_EVENTS, -1);
+
+    for (int i = 0; i < count; i++) {
+        events[i].session = ready[i].data.u32;
+        events[i].writable = (ready[i].events & EPOLLOUT) != 0;}
+
+    return count;}
+
+#else
+
+/**
+ * @brief Creates the event loop's kqueue.
+ */
+static int pollerCreate(void) {
+
+    return kqueue();}
+
+/**
+ * @brief Watches a socket for input, or only for room to write output.
+ */
+static int pollerWatch(int poller, int descriptor, uint32_t session, int writable, int add) {
+
+    struct kevent changes[2];
+    void *data = (void *) (uintptr_t) session;
+
+    (void) add; // EV_ADD both registers and modifies a filter
+    EV_SET(&changes[0], descriptor, EVFILT_READ, EV_ADD | (writable ? EV_DISABLE : EV_ENABLE), 0, 0, data);
+    EV_SET(&changes[1], descriptor, EVFILT_WRITE, EV_ADD | (writable ? EV_ENABLE : EV_DISABLE), 0, 0, data);
+
+    return kevent(poller, changes, 2, NULL, 0, NULL);}
+
+/**
+ * @brief Waits for readiness notifications; returns their number or -1.
+ */
+static int pollerWait(int poller, ServerEvent *events, int capacity) {
+
+    struct kevent ready[SERVER_MAX_EVENTS];
+    int count = kevent(poller, NULL, 0, ready, (capacity < SERVER_MAX_EVENTS) ? capacity : SERVER_MAX_EVENTS, NULL);
+
+    for (int i = 0; i < count; i++) {
+        events[i].session = (uint32_t) (uintptr_t) ready[i].udata;
+        events[i].writable = (ready[i].filter == EVFILT_WRITE);}
+
+    return count;}
+
+#endif
+
+/**
+ * @brief Gives the WebSocket text message being written its header, if one is open.
+ *
+ * Room for the longest header is kept in front of the text; a message short
+ * enough for the two-byte header has its text moved up into the spare bytes.
+ * Nothing is written after an open message, so it ends scratch and the last part.
+ */
+static void sessionEndMessage(Server *server) {
+
+    size_t start = server->textMessage;
+
+    if (start == SERVER_NO_OFFSET)
+        return;
+
+    uint8_t header[WEBSOCKET_TEXT_HEADER];
+    size_t length = server->scratchLength - start - WEBSOCKET_TEXT_HEADER;
+    size_t size = webSocketHeader(header, 1, length);
+    size_t spare = WEBSOCKET_TEXT_HEADER - size;
+
+    memmove(server->scratch + start + size, server->scratch + start + WEBSOCKET_TEXT_HEADER, length);
+    memcpy(server->scratch + start, header, size);
+    server->scratchLength -= spare;
+    server->parts[server->partCount - 1].iov_len -= spare;
+    server->textMessage = SERVER_NO_OFFSET;}
+
+/**
+ * @brief Sends the output gathered for the session being handled, queueing whatever its socket does not accept; returns -1 on failure.
+ *
+ * Nothing is sent directly while older output is still queued, so the bytes
+ * stay in order. Queued text is copied out of scratch, queued frames are
+ * only referenced.
+ */
+static int serverFlush(Server *server, Session *session) {
+
+    sessionEndMessage(server);
+
+    struct iovec *part = server->parts;
+    int remaining = server->partCount;
+    int status = 0;
+
+    while ((session->outputHead == SESSION_NONE) && (remaining > 0)) {
+
+        ssize_t sent = writev(session->descriptor, part, remaining);
+
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+                status = -1;
+
+            break;}
+
+        for (; (remaining > 0) && ((size_t) sent >= part->iov_len); part++, remaining--)
+            sent -= (ssize_t) part->iov_len;
+
+        if (remaining > 0) {
+            part->iov_base = (char *) part->iov_base + sent;
+            part->iov_len -= (size_t) sent;}}
+
+    for (; (status == 0) && (remaining > 0); part++, remaining--)
+        status = server->partShared[part - server->parts]
+            ? sessionQueueShared(&server->output, session, part->iov_base, part->iov_len)
+            : sessionQueueOutput(&server->output, session, part->iov_base, part->iov_len);
+
+    server->partCount = 0;
+    server->scratchLength = 0;
+    server->storedBlock = SERVER_NO_OFFSET;
+    server->textMessage = SERVER_NO_OFFSET;
+
+    return status;}
+
+/**
+ * @brief Starts a new part of output, flushing first if the part list is full; returns -1 on failure.
+ */
+static int sessionAddPart(Server *server, Session *session, const char *data, size_t length, int shared) {
+
+    if ((server->partCount == SERVER_MAX_PARTS) && (serverFlush(server, session) != 0))
+        return -1;
+
+    server->parts[server->partCount] = (struct iovec) {(void *) data, length};
+    server->partShared[server->partCount++] = (uint8_t) shared;
+
+    return 0;}
+
+/**
+ * @brief Adds a copy of some bytes, as they are, to the output of the session being handled; returns -1 on failure.
+ */
+static int sessionWriteRaw(Server *server, Session *session, const char *data, size_t length) {
+
+    while (length > 0) {
+
+        // Flushed before writing, so the text stays where its part points.
+        if (((server->scratchLength == SERVER_SCRATCH_SIZE) || (server->partCount == SERVER_MAX_PARTS)) && (serverFlush(server, session) != 0))
+            return -1;
+
+        size_t room = SERVER_SCRATCH_SIZE - server->scratchLength;
+        size_t chunk = (length < room) ? length : room;
+        char *destination = server->scratch + server->scratchLength;
+        struct iovec *last = (server->partCount > 0) ? &server->parts[server->partCount - 1] : NULL;
+
+        memcpy(destination, data, chunk);
+
+        // Text that follows text just written extends the same part.
+        if ((last != NULL) && !server->partShared[server->partCount - 1] && ((char *) last->iov_base + last->iov_len == destination))
+            last->iov_len += chunk;
+
+        else if (sessionAddPart(server, session, destination, chunk, 0) != 0)
+            return -1;
+
+        server->scratchLength += chunk;
+        data += chunk;
+        length -= chunk;}
+
+    return 0;}
+
+/**
+ * @brief Adds a copy of some text to the output of a WebSocket session as text messages; returns -1 on failure.
+ *
+ * Text written right after text goes in the same message, so the prompts
+ * and messages handled at once reach the browser as one message.
+ */
+static int sessionWriteMessage(Server *server, Session *session, const char *data, size_t length) {
+
+    while (length > 0) {
+
+        size_t used = (server->textMessage != SERVER_NO_OFFSET) ? server->scratchLength - server->textMessage - WEBSOCKET_TEXT_HEADER : 0;
+        size_t room = SERVER_SCRATCH_SIZE - server->scratchLength;
+        size_t chunk = (length < WEBSOCKET_MESSAGE_MAX - used) ? length : WEBSOCKET_MESSAGE_MAX - used;
+
+        if (chunk > room)
+            chunk = room;
+
+        // Without an open message, or one that is full or fills scratch, a new one starts (after a flush if scratch has no room).
+        if ((server->textMessage == SERVER_NO_OFFSET) || (chunk == 0)) {
+
+            uint8_t header[WEBSOCKET_TEXT_HEADER] = {0};    // Filled in by sessionEndMessage
+
+            sessionEndMessage(server);
+            chunk = (length < WEBSOCKET_MESSAGE_MAX) ? length : WEBSOCKET_MESSAGE_MAX;
+
+            if (chunk > SERVER_SCRATCH_SIZE - WEBSOCKET_TEXT_HEADER)
+                chunk = SERVER_SCRATCH_SIZE - WEBSOCKET_TEXT_HEADER;
+
+            if (((server->scratchLength + WEBSOCKET_TEXT_HEADER + chunk > SERVER_SCRATCH_SIZE) || (server->partCount == SERVER_MAX_PARTS))
+                    && (serverFlush(server, session) != 0))
+                return -1;
+
+            if (sessionWriteRaw(server, session, (const char *) header, WEBSOCKET_TEXT_HEADER) != 0)
+                return -1;
+
+            server->textMessage = server->scratchLength - WEBSOCKET_TEXT_HEADER;}
+
+        if (sessionWriteRaw(server, session, data, chunk) != 0)
+            return -1;
+
+        data += chunk;
+        length -= chunk;}
+
+    return 0;}
+
+/**
+ * @brief Adds the bytes of a complete WebSocket frame, after ending the text message being written; returns -1 on failure.
+ */
+static int sessionWriteFrame(Server *server, Session *session, const void *frame, size_t length) {
+
+    sessionEndMessage(server);
+
+    return sessionWriteRaw(server, session, frame, length);}
+
+/**
+ * @brief Adds a copy of some text to the output of the session being handled; returns -1 on failure.
+ *
+ * In a compressed session, the text goes in stored blocks: it costs no
+ * compressor state, and text written right after text extends the same
+ * block rather than starting a new one.
+ */
+static int sessionWrite(Server *server, Session *session, const char *data, size_t length) {
+
+    if (session->websocket)
+        return sessionWriteMessage(server, session, data, length);
+
+    if (!session->compressed)
+        return sessionWriteRaw(server, session, data, length);
+
+    while (length > 0) {
+
+        size_t block = server->storedBlock;
+        size_t room = SERVER_SCRATCH_SIZE - server->scratchLength;
+        struct iovec *last = (server->partCount > 0) ? &server->parts[server->partCount - 1] : NULL;
+
+        // The open block must still end the output, with room for more text in it and in scratch.
+        if ((block != SERVER_NO_OFFSET) && (last != NULL) && !server->partShared[server->partCount - 1] && ((char *) last->iov_base + last->iov_len == server->scratch + server->scratchLength)) {
+
+            uint8_t *header = (uint8_t *) server->scratch + block;
+            size_t used = header[1] | (size_t) header[2] << 8;
+            size_t chunk = (length < DEFLATE_STORED_MAX - used) ? length : DEFLATE_STORED_MAX - used;
+
+            if ((chunk > 0) && (chunk <= room)) {
+                deflateStoredHeader(header, used + chunk);
+
+                if (sessionWriteRaw(server, session, data, chunk) != 0)
+                    return -1;
+
+                data += chunk;
+                length -= chunk;
+                continue;}}
+
+        // Otherwise a new block: its header, then as much text as it holds.
+        uint8_t header[DEFLATE_STORED_HEADER];
+        size_t chunk = (length < DEFLATE_STORED_MAX) ? length : DEFLATE_STORED_MAX;
+
+        if ((DEFLATE_STORED_HEADER + chunk > room) && (serverFlush(server, session) != 0))
+            return -1;
+
+        deflateStoredHeader(header, chunk);
+
+        if ((sessionWriteRaw(server, session, (const char *) header, DEFLATE_STORED_HEADER) != 0) || (sessionWriteRaw(server, session, data, chunk) != 0))
+            return -1;
+
+        // Unless a flush came between them, the header and the text are the end of scratch.
+        server->storedBlock = (server->scratchLength >= DEFLATE_STORED_HEADER + chunk) ? server->scratchLength - chunk - DEFLATE_STORED_HEADER : SERVER_NO_OFFSET;
+        data += chunk;
+        length -= chunk;}
+
+    return 0;}
+
+/**
+ * @brief Adds shared immutable bytes (a round frame) to the output of the session being handled, by reference.
+ */
+static int sessionWriteShared(Server *server, Session *session, const char *data, size_t length) {
+
+    return sessionAddPart(server, session, data, length, 1);}
+
+/**
+ * @brief Adds a null-terminated string to the output of the session being handled.
+ */
+static int sessionPrint(Server *server, Session *session, const char *text) {
+
+    return sessionWrite(server, session, text, strlen(text));}
+
+/**
+ * @brief Queues the prompt for the next choice.
+ */
+static int sessionPromptChoice(Server *server, Session *session) {
+
+    return sessionPrint(server, session, "\nStone, Paper or Scissors: ");}
+
+/**
+ * @brief Queues the result banner of a finished series.
+ *
+ * A result seen before is a lookup and a copy (of the deflated banner, for
+ * a compressed session); only a new one is formatted and rendered, then
+ * deflated once if a compressed session needs it.
+ */
+static int sessionWriteBanner(Server *server, Session *session, int playerWins, int computerWins) {
+
+    size_t length;
+    int width = server->config->bannerWidth;
+    uint64_t start = metricsStart();
+    const char *deflated = (session->compressed && (server->assets->font != NULL))
+        ? bannerCacheFind(&server->deflatedBanners, session->playerName, playerWins, computerWins, width, &length) : NULL;
+
+    if (deflated != NULL) {
+        metricsStop(METRIC_BANNER, start);
+        return sessionWriteRaw(server, session, deflated, length);}
+
+    const char *banner = (server->assets->font != NULL) ? bannerCacheFind(&server->banners, session->playerName, playerWins, computerWins, width, &length) : NULL;
+    char winMessage[MAX_WIN_MESSAGE_BUFFER];
+    char *rendered = NULL;
+
+    if (banner == NULL) {
+        formatWinMessage(winMessage, sizeof winMessage, session->playerName, playerWins, computerWins);
+        rendered = (server->assets->font != NULL) ? bannerRender(server->assets->font, winMessage, width, &length) : NULL;
+
+        // A banner the cache cannot take is still sent.
+        if (rendered != NULL)
+            bannerCacheInsert(&server->banners, session->playerName, playerWins, computerWins, width, rendered, length);
+
+        banner = rendered;}
+
+    // Deflated into a buffer of its own: the cache may not take it either.
+    uint8_t *compressed = (session->compressed && (banner != NULL)) ? malloc(DEFLATE_BOUND(length)) : NULL;
+    size_t compressedLength = 0;
+
+    if (compressed != NULL) {
+        compressedLength = deflateCompress(banner, length, compressed);
+        bannerCacheInsert(&server->deflatedBanners, session->playerName, playerWins, computerWins, width, (const char *) compressed, compressedLength);}
+
+    metricsStop(METRIC_BANNER, start);
+
+    int status = (banner == NULL) ? sessionPrint(server, session, winMessage)
+        : (compressed != NULL) ? sessionWriteRaw(server, session, (const char *) compressed, compressedLength)
+        : sessionWrite(server, session, banner, length);
+
+    free(compressed);
+    free(rendered);
+
+    return status;}
+
+/**
+ * @brief Plays one round with the player's choice and queues the frame and scores.
+ */
+static int sessionPlayRound(Server *server, uint32_t id, int playerChoice) {
+
+    Session *session = sessionAt(&server->sessions, id);
+    SessionSlab *slab = sessionSlab(&server->sessions, id);
+    uint32_t slot = sessionSlot(id);
+    int computerChoice;
+    int outcome;
+
+    // A checkpointed series is played in its record, and the slab's counters follow it.
+    if (session->checkpoint != CHECKPOINT_NONE) {
+        CheckpointRecord *record = checkpointRecord(server->assets->checkpoint, session->checkpoint);
+
+        outcome = seriesPlayRound(&record->series, playerChoice, &computerChoice);
+        slab->playerWins[slot] = record->series.playerWins;
+        slab->computerWins[slot] = record->series.computerWins;
+        record->live = !seriesOver(&record->series);
+        checkpointTouch(&server->checkpoints, session->checkpoint);}
+
+    else {
+        computerChoice = randomNumber(1, 3);
+        outcome = resolveRound(playerChoice, computerChoice);
+
+        // Branch-free score update: a tie adds to neither counter.
+        slab->playerWins[slot] += (outcome == ROUND_PLAYER_WINS);
+        slab->computerWins[slot] += (outcome == ROUND_COMPUTER_WINS);}
+
+    const RoundFrame *frame = &server->config->frames[playerChoice - 1][computerChoice - 1];
+
+    int over = (slab->playerWins[slot] == slab->winsNeeded[slot]) || (slab->computerWins[slot] == slab->winsNeeded[slot]);
+
+    // A browser draws the frame, scores, prompt and closing dots itself from one binary message.
+    if (session->websocket) {
+        uint8_t message[WEBSOCKET_ROUND_LENGTH];
+
+        webSocketRoundMessage(message, playerChoice, computerChoice, outcome, slab->playerWins[slot], slab->computerWins[slot], slab->winsNeeded[slot]);
+
+        if (sessionWriteFrame(server, session, message, sizeof message) != 0)
+            return -1;
+
+        if (!over)
+            return 0;
+
+        session->state = SESSION_CLOSING;
+        return sessionWriteBanner(server, session, slab->playerWins[slot], slab->computerWins[slot]);}
+
+    // A compressed session gets the frame's deflate blocks, spliced into its stream as they are.
+    const CompressedFrame *compressed = session->compressed ? &server->assets->compressedFrames[playerChoice - 1][computerChoice - 1] : NULL;
+    int status = (compressed != NULL) ? sessionWriteShared(server, session, (const char *) compressed->data, compressed->length)
+        : sessionWriteShared(server, session, frame->text, frame->lineOffsets[ART_HEIGHT]);
+
+    if (status != 0)
+        return -1;
+
+    if (!over) {
+        char scores[MAX_WIN_MESSAGE_BUFFER];
+
+        snprintf(scores, sizeof scores, "\n%s : %i | Computer : %i\n", session->playerName, slab->playerWins[slot], slab->computerWins[slot]);
+
+        return ((sessionPrint(server, session, scores) == 0) && (sessionPromptChoice(server, session) == 0)) ? 0 : -1;}
+
+    // Game over: the same closing dots and banner as the interactive game.
+    session->state = SESSION_CLOSING;
+
+    if (sessionPrint(server, session, "\n.\n..\n...\n\n") != 0)
+        return -1;
+
+    return sessionWriteBanner(server, session, slab->playerWins[slot], slab->computerWins[slot]);}
+
+/**
+ * @brief Formats the counters of the session and output pools, then the phase histograms.
+ *
+ * @return Length of the text.
+ */
+static size_t serverFormatStats(const Server *server, char *buffer, size_t size);
+
+/**
+ * @brief Starts a telnet session's series in a free record of the checkpoint file and gives the player its resume code.
+ *
+ * The series' seed is drawn from the loop's stream, so a seeded server
+ * plays the same series. With every record of the loop taken, the series
+ * is played without a checkpoint.
+ */
+static int sessionCheckpointBegin(Server *server, uint32_t id, int bestOf) {
+
+    CheckpointFile *file = server->assets->checkpoint;
+    Session *session = sessionAt(&server->sessions, id);
+    uint32_t index = checkpointClaim(file, &server->checkpointCursor, server->loop, (uint32_t) server->config->threads);
+
+    if (index == CHECKPOINT_NONE)
+        return 0;
+
+    CheckpointRecord *record = checkpointRecord(file, index);
+    uint64_t seed = (uint64_t) rngNext32(rngDefault()) << 32 | rngNext32(rngDefault());
+    char code[64];
+
+    seriesBegin(&record->series, server->config->rngKind, seed, &(StrategySpec) {STRATEGY_RANDOM, STRATEGY_DEFAULT_ORDER}, session->playerName, bestOf);
+    record->live = 1;
+    session->checkpoint = index;
+    checkpointTouch(&server->checkpoints, index);
+    snprintf(code, sizeof code, "\nResume code: %0*llx\n", CHECKPOINT_CODE_LENGTH, (unsigned long long) checkpointCode(file, index));
+
+    return sessionPrint(server, session, code);}
+
+/**
+ * @brief Continues the checkpointed series of a resume code, after checking it against its replay; an unknown code asks for the name again.
+ */
+static int sessionResume(Server *server, uint32_t id, const char *code) {
+
+    CheckpointFile *file = server->assets->checkpoint;
+    Session *session = sessionAt(&server->sessions, id);
+    char *end;
+    uint64_t value = strtoull(code, &end, 16);
+    uint32_t index = ((end != code) && (*end == '\0')) ? checkpointResume(file, value) : CHECKPOINT_NONE;
+
+    if (index == CHECKPOINT_NONE)
+        return sessionPrint(server, session, "\nNo series in progress has this code...\n\nPlayer name: ");
+
+    SeriesState *series = &checkpointRecord(file, index)->series;
+    SessionSlab *slab = sessionSlab(&server->sessions, id);
+    uint32_t slot = sessionSlot(id);
+    char welcome[128];
+
+    if (seriesVerify(series) == 1)
+        checkpointTouch(&server->checkpoints, index);
+
+    memcpy(session->playerName, series->playerName, MAX_PLAYER_NAME);
+    slab->playerWins[slot] = series->playerWins;
+    slab->computerWins[slot] = series->computerWins;
+    slab->winsNeeded[slot] = series->winsNeeded;
+    session->checkpoint = index;
+    session->state = SESSION_CHOICE;
+    choiceTokenizerInit(&session->choice);
+    server->resumedSeries++;
+    snprintf(welcome, sizeof welcome, "\nWelcome back, %s: best of %i at %i : %i\n", session->playerName, (int) series->bestOf,
+        (int) series->playerWins, (int) series->computerWins);
+
+    return ((sessionPrint(server, session, welcome) == 0) && (sessionPromptChoice(server, session) == 0)) ? 0 : -1;}
+
+/**
+ * @brief Handles one complete input line of a session; returns -1 if the session must be dropped.
+ */
+static int sessionHandleLine(Server *server, uint32_t id, const char *line, size_t length) {
+
+    Session *session = sessionAt(&server->sessions, id);
+
+    switch (session->state) {
+
+        case SESSION_NAME:
+            // A monitoring client gets the counters instead of a game.
+            if ((length == sizeof SERVER_METRICS_LINE - 1) && (memcmp(line, SERVER_METRICS_LINE, length) == 0)) {
+                char stats[SERVER_STATS_BUFFER];
+
+                session->state = SESSION_CLOSING;
+                return sessionWrite(server, session, stats, serverFormatStats(server, stats, sizeof stats));}
+
+            // A telnet player back after a disconnect or a restart continues a checkpointed series.
+            if ((server->assets->checkpoint != NULL) && !session->websocket && (length > sizeof SERVER_RESUME_LINE - 1)
+                    && (memcmp(line, SERVER_RESUME_LINE, sizeof SERVER_RESUME_LINE - 1) == 0))
+                return sessionResume(server, id, line + sizeof SERVER_RESUME_LINE - 1);
+
+            // Like fgets into the name buffer: anything beyond it is discarded.
+            if (length > MAX_PLAYER_NAME - 1)
+                length = MAX_PLAYER_NAME - 1;
+
+            // A browser's text messages must stay UTF-8: the name is not cut inside a character.
+            while (session->websocket && (length > 0) && (((unsigned char) line[length] & 0xc0) == 0x80))
+                length--;
+
+            memcpy(session->playerName, line, length);
+            session->playerName[length] = '\0';
+            session->state = SESSION_BEST_OF;
+
+            return sessionPrint(server, session, "\nBest of: ");
+
+        case SESSION_BEST_OF: {
+            // Like scanf's %i, blank lines are skipped.
+            if (strspn(line, " \t\r\v\f") == length)
+                return 0;
+
+            char *end;
+            errno = 0;
+            long number = strtol(line, &end, 0);    // Base 0 accepts decimal, octal and hex, as %i does
+
+            if ((end == line) || (errno == ERANGE) || (number > INT_MAX) || (number < INT_MIN)) {
+                session->state = SESSION_CLOSING;
+                return sessionPrint(server, session, "Invalid input...\n\n");}
+
+            // Must be a positive odd integer.
+            if ((number % 2 == 0) || (number < 0)) {
+                session->state = SESSION_CLOSING;
+                return sessionPrint(server, session, "\nOnly positive odd integers are valid...\n\n");}
+
+            sessionSlab(&server->sessions, id)->winsNeeded[sessionSlot(id)] = (int32_t) ((number + 1) / 2);
+            session->state = SESSION_CHOICE;
+            choiceTokenizerInit(&session->choice);
+
+            // The browser page has no way to resume, so only telnet series are checkpointed.
+            if ((server->assets->checkpoint != NULL) && !session->websocket && (sessionCheckpointBegin(server, id, (int) number) != 0))
+                return -1;
+
+            return sessionPromptChoice(server, session);}
+
+        default:
+            return 0;   // Choices are tokenized as they arrive, and input after the end of the game is ignored
+    }}
+
+/**
+ * @brief Handles one choice line of a session as returned by the tokenizer; returns -1 if the session must be dropped.
+ */
+static int sessionHandleChoice(Server *server, uint32_t id, int choice) {
+
+    Session *session = sessionAt(&server->sessions, id);
+
+    // The round message of a browser starts a line of its own.
+    if ((!session->websocket || (choice <= 0)) && (sessionPrint(server, session, "\n") != 0))
+        return -1;
+
+    if (choice > 0)
+        return sessionPlayRound(server, id, choice);
+
+    if (choice == CHOICE_EXHAUSTED) {
+        session->state = SESSION_CLOSING;
+        return sessionPrint(server, session, "Invalid Choice...\nToo many invalid inputs...\n");}
+
+    return ((sessionPrint(server, session, "Invalid Choice...\n") == 0) && (sessionPromptChoice(server, session) == 0)) ? 0 : -1;}
+
+/**
+ * @brief Adds received bytes to a session's input line, handling the line once its newline arrives.
+ *
+ * @param status Set to -1 if the session must be dropped, 0 otherwise.
+ * @return Number of bytes consumed: up to and including the first newline, or all of them.
+ */
+static size_t sessionReceiveLine(Server *server, uint32_t id, const char *data, size_t length, int *status) {
+
+    Session *session = sessionAt(&server->sessions, id);
+    const char *newline = memchr(data, '\n', length);
+    size_t lineLength = (newline != NULL) ? (size_t) (newline - data) : length;
+    size_t room = SESSION_LINE_BUFFER - 1 - session->lineLength;
+    size_t kept = (lineLength < room) ? lineLength : room;
+
+    memcpy(session->line + session->lineLength, data, kept);
+    session->lineLength += (uint8_t) kept;
+    *status = 0;
+
+    if (newline == NULL)
+        return length;
+
+    size_t used = session->lineLength;
+
+    if ((used > 0) && (session->line[used - 1] == '\r'))    // Telnet-style line ending
+        used--;
+
+    session->line[used] = '\0';
+    session->lineLength = 0;
+    *status = sessionHandleLine(server, id, session->line, used);
+
+    return lineLength + 1;}
+
+/**
+ * @brief Answers a browser's request once its headers are complete: the WebSocket handshake, the client page or a 404.
+ */
+static int sessionAnswerHttp(Server *server, Session *session) {
+
+    if (!session->request.root) {
+        session->state = SESSION_CLOSING;
+        return sessionWriteRaw(server, session, WEB_NOT_FOUND, sizeof WEB_NOT_FOUND - 1);}
+
+    if (session->request.keyLength != WEBSOCKET_KEY_LENGTH) {
+        session->state = SESSION_CLOSING;
+        server->pagesServed++;
+        return sessionWriteShared(server, session, server->assets->page, server->assets->pageLength);}
+
+    char accept[WEBSOCKET_ACCEPT_LENGTH];
+
+    webSocketAccept(session->request.key, accept);
+
+    if ((sessionWriteRaw(server, session, WEB_UPGRADE, sizeof WEB_UPGRADE - 1) != 0) || (sessionWriteRaw(server, session, accept, sizeof accept) != 0)
+            || (sessionWriteRaw(server, session, "\r\n\r\n", 4) != 0))
+        return -1;
+
+    // From here on the game is the same, in WebSocket messages.
+    session->websocket = 1;
+    session->state = SESSION_NAME;
+    session->lineLength = 0;
+    server->webSessions++;
+
+    return sessionPrint(server, session, "\nPlayer name: ");}
+
+/**
+ * @brief Reads the headers of a browser's HTTP request, keeping only what the answer depends on.
+ *
+ * Lines are matched as they arrive, so headers of any length cost no
+ * memory: the request line against WEB_REQUEST_LINE, every other line
+ * against WEB_KEY_HEADER, whose value is kept.
+ *
+ * @param status Set to -1 if the session must be dropped, 0 otherwise.
+ * @return Number of bytes consumed: all of them (nothing is expected after the headers before the answer).
+ */
+static size_t sessionReceiveHttp(Server *server, Session *session, const char *data, size_t length, int *status) {
+
+    *status = 0;
+
+    for (size_t i = 0; i < length; i++) {
+
+        char c = data[i];
+        int requestLine = (session->request.lines == 0);
+        size_t prefix = requestLine ? WEB_REQUEST_LINE_LENGTH : WEB_KEY_HEADER_LENGTH;
+
+        if (c == '\r')
+            continue;
+
+        if (c == '\n') {
+            if (requestLine)
+                session->request.root = session->request.matching && (session->request.column >= WEB_REQUEST_LINE_LENGTH);
+
+            // A blank line ends the headers.
+            else if (session->request.column == 0) {
+                *status = sessionAnswerHttp(server, session);
+                return length;}
+
+            session->request.lines += (session->request.lines < UINT8_MAX);
+            session->request.column = 0;
+            session->request.matching = 1;
+            continue;}
+
+        if (session->request.matching && (session->request.column < prefix))
+            session->request.matching = requestLine ? (c == WEB_REQUEST_LINE[session->request.column])
+                : (tolower((unsigned char) c) == WEB_KEY_HEADER[session->request.column]);
+
+        // The key's value, without the blanks around it.
+        else if (session->request.matching && !requestLine && (c != ' ') && (c != '\t') && (session->request.keyLength < WEBSOCKET_KEY_LENGTH))
+            session->request.key[session->request.keyLength++] = c;
+
+        session->request.column += (session->request.column < UINT8_MAX);}
+
+    return length;}
+
+/**
+ * @brief Closes a session's connection and returns its state to the pools.
+ */
+static void sessionClose(Server *server, uint32_t id) {
+
+    Session *session = sessionAt(&server->sessions, id);
+
+    close(session->descriptor); // Also removes it from the event loop
+
+    // A series that is not over stays in its record, for its code to resume.
+    if (session->checkpoint != CHECKPOINT_NONE)
+        checkpointRelease(server->assets->checkpoint, session->checkpoint);
+
+    sessionDropOutput(&server->output, session);
+    server->partCount = 0;      // Output gathered but not flushed is dropped too
+    server->scratchLength = 0;
+    server->storedBlock = SERVER_NO_OFFSET;
+    server->textMessage = SERVER_NO_OFFSET;
+    sessionRelease(&server->sessions, id);}
+
+/**
+ * @brief Chooses what to wait for next from the session's queued output; closes the session when it is done.
+ */
+static void sessionUpdate(Server *server, uint32_t id) {
+
+    Session *session = sessionAt(&server->sessions, id);
+    int pending = (session->outputHead != SESSION_NONE);
+
+    // Stop reading while the client is not reading its output.
+    if (pending != session->writing) {
+
+        session->writing = (uint8_t) pending;
+
+        if (pollerWatch(server->poller, session->descriptor, id, pending, 0) != 0) {
+            sessionClose(server, id);
+            return;}}
+
+    if (!pending && (session->state == SESSION_CLOSING)) {
+
+        // Closing with the browser's last frames unread would reset the connection and lose the end of the game.
+        if (session->websocket == 2) {
+            session->websocket = 3;
+
+            if (shutdown(session->descriptor, SHUT_WR) == 0)
+                return;}
+
+        sessionClose(server, id);}}
+
+/**
+ * @brief Sends queued output once the socket has room again.
+ */
+static void sessionWritable(Server *server, uint32_t id) {
+
+    if (sessionSendOutput(&server->output, sessionAt(&server->sessions, id)) < 0)
+        sessionClose(server, id);
+
+    else
+        sessionUpdate(server, id);}
+
+/**
+ * @brief Starts MCCP2 for a session that accepted it: everything queued after this is part of its zlib stream.
+ */
+static int sessionStartCompression(Server *server, Session *session) {
+
+    if ((sessionWriteRaw(server, session, TELNET_START_COMPRESS2, sizeof TELNET_START_COMPRESS2 - 1) != 0)
+            || (sessionWriteRaw(server, session, DEFLATE_ZLIB_HEADER, DEFLATE_ZLIB_HEADER_LENGTH) != 0))
+        return -1;
+
+    session->compressed = 1;
+    server->compressedSessions++;
+
+    return 0;}
+
+/**
+ * @brief Removes the telnet commands from received bytes, starting compression if the client accepts MCCP2.
+ *
+ * @param status Set to -1 if the session must be dropped, 0 otherwise.
+ * @return Number of bytes left in data: the input without the commands.
+ */
+static size_t sessionFilterTelnet(Server *server, Session *session, char *data, size_t length, int *status) {
+
+    size_t kept = 0;
+
+    *status = 0;
+
+    for (size_t i = 0; i < length; i++) {
+
+        uint8_t byte = (uint8_t) data[i];
+
+        switch (session->telnet) {
+
+            case TELNET_TEXT:
+                if (byte == TELNET_IAC)
+                    session->telnet = TELNET_COMMAND;
+
+                else
+                    data[kept++] = (char) byte;
+
+                break;
+
+            case TELNET_COMMAND:
+                // IAC IAC is an escaped 0xff; commands without an option (NOP, GA, ...) end here.
+                if (byte == TELNET_IAC)
+                    data[kept++] = (char) byte;
+
+                session->telnet = (byte == TELNET_IAC) ? TELNET_TEXT : (byte == TELNET_DO) ? TELNET_OPTION_DO
+                    : (byte >= TELNET_WILL) ? TELNET_OPTION : (byte == TELNET_SB) ? TELNET_SUBNEGOTIATION : TELNET_TEXT;
+                break;
+
+            case TELNET_OPTION_DO:
+                if ((byte == TELNET_COMPRESS2) && !session->compressed && (sessionStartCompression(server, session) != 0))
+                    *status = -1;
+
+                session->telnet = TELNET_TEXT;
+                break;
+
+            case TELNET_OPTION:
+                session->telnet = TELNET_TEXT;
+                break;
+
+            case TELNET_SUBNEGOTIATION:
+                if (byte == TELNET_IAC)
+                    session->telnet = TELNET_SUBNEGOTIATION_IAC;
+
+                break;
+
+            default:
+                session->telnet = (byte == TELNET_SE) ? TELNET_TEXT : TELNET_SUBNEGOTIATION;
+                break;}}
+
+    return kept;}
+
+/**
+ * @brief Reads what a session sent and plays every complete line.
+ */
+static void sessionReceive(Server *server, uint32_t id) {
+
+    Session *session = sessionAt(&server->sessions, id);
+    char chunk[SERVER_RECEIVE_CHUNK];
+    char decoded[SERVER_RECEIVE_CHUNK + 1];     // Payload of a WebSocket session's frames
+    char *input = chunk;
+    ssize_t received = recv(session->descriptor, chunk, sizeof chunk, 0);
+
+    if (received < 0) {
+        if ((errno != EINTR) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+            sessionClose(server, id);
+
+        return;}
+
+    if (received == 0) {    // The player left
+        sessionClose(server, id);
+        return;}
+
+    // A browser's input is the payload of its frames, each message a line.
+    if (session->websocket) {
+        int events;
+
+        received = (ssize_t) webSocketDecode(&session->reader, (const uint8_t *) chunk, (size_t) received, decoded, &events);
+        input = decoded;
+
+        // After the game, whatever the browser sends until its close frame is dropped.
+        if ((events & WEBSOCKET_EVENT_ERROR) || ((session->websocket == 3) && (events & WEBSOCKET_EVENT_CLOSE))
+                || ((events & WEBSOCKET_EVENT_PING) && (session->websocket == 1) && (sessionWriteFrame(server, session, WEBSOCKET_PONG_FRAME, WEBSOCKET_CONTROL_FRAME_LENGTH) != 0))) {
+            sessionClose(server, id);
+            return;}
+
+        if (session->websocket == 3)
+            return;
+
+        // The browser left: the close frame is answered and the connection closed once the output is out.
+        if (events & WEBSOCKET_EVENT_CLOSE)
+            session->state = SESSION_CLOSING;}
+
+    // Telnet clients are only expected where compression is offered; elsewhere every byte is input.
+    else if (server->config->compress) {
+        int status;
+
+        received = (ssize_t) sessionFilterTelnet(server, session, chunk, (size_t) received, &status);
+
+        if (status != 0) {
+            sessionClose(server, id);
+            return;}}
+
+    // Choices go through the session's tokenizer, the name and 'Best of' lines through its line buffer.
+    for (size_t used = 0; (used < (size_t) received) && (session->state != SESSION_CLOSING); ) {
+
+        int status = 0;
+
+        if (session->state == SESSION_CHOICE) {
+            int choice;
+
+            used += choiceTokenizerFeed(&session->choice, input + used, (size_t) received - used, &choice);
+
+            if (choice != CHOICE_PENDING)
+                status = sessionHandleChoice(server, id, choice);}
+
+        else if (session->state == SESSION_HTTP)
+            used += sessionReceiveHttp(server, session, input + used, (size_t) received - used, &status);
+
+        else
+            used += sessionReceiveLine(server, id, input + used, (size_t) received - used, &status);
+
+        if (status != 0) {
+            sessionClose(server, id);
+            return;}}
+
+    // A WebSocket game ends with a close frame after its last message.
+    if ((session->websocket == 1) && (session->state == SESSION_CLOSING)) {
+        session->websocket = 2;
+
+        if (sessionWriteFrame(server, session, WEBSOCKET_CLOSE_FRAME, WEBSOCKET_CONTROL_FRAME_LENGTH) != 0) {
+            sessionClose(server, id);
+            return;}}
+
+    if (serverFlush(server, session) != 0)
+        sessionClose(server, id);
+
+    else
+        sessionUpdate(server, id);}
+
+/**
+ * @brief Accepts every pending connection and greets it with the first prompt (a browser's request is read first).
+ */
+static void serverAccept(Server *server, int web) {
+
+    for (;;) {
+
+        int descriptor = accept(web ? server->webListener : server->listener, NULL, NULL);
+
+        if (descriptor < 0) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+                perror("Accept failed");
+
+            return;}
+
+        uint32_t id = sessionAcquire(&server->sessions);
+
+        if ((id == SESSION_NONE) || (fcntl(descriptor, F_SETFL, O_NONBLOCK) != 0) || (pollerWatch(server->poller, descriptor, id, 0, 1) != 0)) {
+            if (id != SESSION_NONE)
+                sessionRelease(&server->sessions, id);
+
+            close(descriptor);
+            continue;}
+
+        Session *session = sessionAt(&server->sessions, id);
+
+        session->descriptor = descriptor;
+        session->checkpoint = CHECKPOINT_NONE;
+
+        // A browser speaks first.
+        if (web) {
+            session->state = SESSION_HTTP;
+            session->request.matching = 1;
+            sessionUpdate(server, id);
+            continue;}
+
+        // The offer comes first, so a client that accepts compresses the rest of the game.
+        if ((server->config->compress && (sessionWriteRaw(server, session, TELNET_OFFER_COMPRESS2, sizeof TELNET_OFFER_COMPRESS2 - 1) != 0))
+                || (sessionPrint(server, session, "\nPlayer name: ") != 0) || (serverFlush(server, session) != 0))
+            sessionClose(server, id);
+
+        else
+            sessionUpdate(server, id);}}
+
+static size_t serverFormatStats(const Server *server, char *buffer, size_t size) {
+
+    const SessionPoolStats *stats = &server->sessions.stats;
+    const BannerCacheStats *banners = &server->banners.stats;
+    const BannerCacheStats *deflated = &server->deflatedBanners.stats;
+    const CheckpointFile *checkpoint = server->assets->checkpoint;
+    size_t frameBytes = 0, compressedBytes = 0;
+
+    for (int p = 0; (p < 3) && server->config->compress; p++)
+        for (int c = 0; c < 3; c++) {
+            frameBytes += server->config->frames[p][c].lineOffsets[ART_HEIGHT];
+            compressedBytes += server->assets->compressedFrames[p][c].length;}
+
+    int written = snprintf(buffer, size, "\nEvent loop %u of %i\nSessions: %lld in use, %lld peak, %lld acquired, %lld released, %lld slots in %lld slabs, %zu bytes per session\n"
+        "Output blocks: %lld in use, %lld allocated (%zu bytes each)\n"
+        "Banner cache: %lld banners, %zu of %zu bytes, %lld hits, %lld misses, %lld evictions\n"
+        "Compression: %lld sessions, %zu frame bytes deflated to %zu, %lld deflated banners in %zu bytes, %lld hits, %lld misses\n"
+        "Browsers: %lld pages served, %lld WebSocket sessions\n"
+        "Checkpoints: %u of %u records used, %lld series resumed, %lld record updates in %lld msync calls\n\n",
+        server->loop, server->config->threads, stats->inUse, stats->peak, stats->acquired, stats->released, stats->capacity, stats->slabs, sessionBytesPerSession(),
+        server->output.inUse, server->output.slabCount * OUTPUT_BLOCKS_PER_SLAB, sizeof(OutputBlock),
+        banners->entries, banners->bytes, banners->capacity, banners->hits, banners->misses, banners->evictions,
+        server->compressedSessions, frameBytes, compressedBytes, deflated->entries, deflated->bytes, deflated->hits, deflated->misses,
+        server->pagesServed, server->webSessions,
+        (checkpoint != NULL) ? checkpointUsed(checkpoint) : 0, (checkpoint != NULL) ? checkpoint->records : 0, server->resumedSeries,
+        server->checkpoints.records, server->checkpoints.syncs);
+    size_t used = ((written > 0) && ((size_t) written < size)) ? (size_t) written : 0;
+
+    return used + metricsFormat(buffer + used, size - used);}
+
+/**
+ * @brief Prints the counters of the session and output pools, and the phase histograms, to stdout.
+ */
+static void serverPrintStats(const Server *server) {
+
+    char text[SERVER_STATS_BUFFER];
+
+    fwrite(text, 1, serverFormatStats(server, text, sizeof text), stdout);
+    fflush(stdout);}
+
+/**
+ * @brief SIGUSR1 handler: asks the event loops to print their pool counters.
+ */
+static void serverRequestStats(int signal) {
+
+    (void) signal;
+    serverStatsGeneration++;}
+
+/**
+ * @brief Opens a non-blocking listening socket, shareable with the other loops if reusePort is set; returns the descriptor or -1.
+ */
+static int serverListen(unsigned short port, int reusePort) {
+
+    int descriptor = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    struct sockaddr_in address = {.sin_family = AF_INET, .sin_port = htons(port), .sin_addr.s_addr = htonl(INADDR_ANY)};
+
+    if (descriptor < 0) {
+        perror("Socket creation failed");
+        return -1;}
+
+    setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+
+#if SERVER_REUSEPORT
+    // Every loop binds its own socket to the port; the kernel spreads new connections over them.
+    if (reusePort && (setsockopt(descriptor, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof reuse) != 0)) {
+        perror("Could not share the port");
+        close(descriptor);
+        return -1;}
+#else
+    (void) reusePort;
+#endif
+
+    if ((bind(descriptor, (struct sockaddr *) &address, sizeof address) != 0) || (listen(descriptor, SERVER_LISTEN_BACKLOG) != 0) || (fcntl(descriptor, F_SETFL, O_NONBLOCK) != 0)) {
+        perror("Could not listen");
+        close(descriptor);
+        return -1;}
+
+    return descriptor;}
+
+/**
+ * @brief Builds the HTTP response carrying the browser client, with the nine frames as a JavaScript array; returns -1 on failure.
+ */
+static int serverBuildPage(ServerAssets *assets, const RoundFrame (*frames)[3]) {
+
+    static const char client[] =
+        # include "sps-web-client.h"
+        ;
+    const char *marker = strstr(client, WEB_FRAMES_MARKER);
+    size_t frameBytes = 0;
+
+    for (int p = 0; p < 3; p++)
+        for (int c = 0; c < 3; c++)
+            frameBytes += frames[p][c].lineOffsets[ART_HEIGHT];
+
+    // Every frame byte takes at most six as a JSON escape; the headers take less than 256.
+    size_t bodyLength = 0, capacity = sizeof client + 6 * frameBytes + 64;
+    char *body = malloc(capacity);
+    char *page = malloc(capacity + 256);
+
+    if ((marker == NULL) || (body == NULL) || (page == NULL)) {
+        fprintf(stderr, "Could not build the browser client...\n");
+        free(body);
+        free(page);
+        return -1;}
+
+    memcpy(body, client, (size_t) (marker - client));
+    bodyLength = (size_t) (marker - client);
+    body[bodyLength++] = '[';
+
+    for (int i = 0; i < 9; i++) {
+
+        const RoundFrame *frame = &frames[i / 3][i % 3];
+
+        body[bodyLength++] = '"';
+
+        // '<' is escaped too, so no frame can close the script element.
+        for (size_t j = 0; j < frame->lineOffsets[ART_HEIGHT]; j++) {
+
+            unsigned char c = (unsigned char) frame->text[j];
+
+            if (c == '\n') {
+                memcpy(body + bodyLength, "\\n", 2);
+                bodyLength += 2;}
+
+            else if ((c < 32) || (c == '<'))
+                bodyLength += (size_t) snprintf(body + bodyLength, 7, "\\u%04x", c);
+
+            else {
+                if ((c == '"') || (c == '\\'))
+                    body[bodyLength++] = '\\';
+
+                body[bodyLength++] = (char) c;}}
+
+        body[bodyLength++] = '"';
+        body[bodyLength++] = (i < 8) ? ',' : ']';}
+
+    size_t rest = strlen(marker + sizeof WEB_FRAMES_MARKER - 1);
+
+    memcpy(body + bodyLength, marker + sizeof WEB_FRAMES_MARKER - 1, rest);
+    bodyLength += rest;
+
+    int headerLength = snprintf(page, 256, "HTTP/1.1 200 OK\r\nContent-Type: text/html; charset=utf-8\r\nContent-Length: %zu\r\n"
+        "Cache-Control: no-cache\r\nConnection: close\r\n\r\n", bodyLength);
+
+    memcpy(page + headerLength, body, bodyLength);
+    free(body);
+    assets->page = page;
+    assets->pageLength = (size_t) headerLength + bodyLength;
+
+    return 0;}
+
+/**
+ * @brief Runs one event loop until waiting for events fails.
+ */
+static void serverLoop(Server *server) {
+
+    for (;;) {
+
+        ServerEvent events[SERVER_MAX_EVENTS];
+        int count = pollerWait(server->poller, events, SERVER_MAX_EVENTS);
+
+        // Every loop prints its own counters once per SIGUSR1 (others at their next wake-up).
+        if (server->statsSeen != serverStatsGeneration) {
+            server->statsSeen = serverStatsGeneration;
+            serverPrintStats(server);}
+
+        if (count < 0) {
+            if (errno == EINTR)
+                continue;
+
+            perror("Event loop failed");
+            break;}
+
+        // A session only ever waits for one of input or output, so it appears at most once per batch.
+        for (int i = 0; i < count; i++) {
+
+            uint64_t start = metricsNow();
+
+            if ((events[i].session == SESSION_NONE) || (events[i].session == SERVER_WEB_LISTENER))
+                serverAccept(server, events[i].session == SERVER_WEB_LISTENER);
+
+            else if (events[i].writable)
+                sessionWritable(server, events[i].session);
+
+            else
+                sessionReceive(server, events[i].session);
+
+            metricsRecord(METRIC_SERVER_EVENT, metricsNow() - start);}
+
+        // The records the batch changed are handed to the kernel with one msync.
+        if (server->assets->checkpoint != NULL)
+            checkpointSync(server->assets->checkpoint, &server->checkpoints);}
+
+    close(server->poller);
+    close(server->listener);
+
+    if (server->webListener >= 0)
+        close(server->webListener);}
+
+/**
+ * @brief Entry point of the threads running loops 1 and up: seeds the thread's own random stream, then runs its loop.
+ */
+static void *serverLoopMain(void *argument) {
+
+    Server *server = argument;
+
+    rngInit(rngDefault(), server->config->rngKind, server->config->seed, server->loop);
+    serverLoop(server);
+
+    return NULL;}
+
+/**
+ * @brief Creates the state of one event loop: its pools, listening socket and poller; returns NULL on failure.
+ */
+static Server *serverCreate(const ServerConfig *config, const ServerAssets *assets, unsigned loop) {
+
+    Server *server = calloc(1, sizeof *server);
+
+    if (server == NULL) {
+        perror("Server allocation failed");
+        return NULL;}
+
+    server->config = config;
+    server->assets = assets;
+    bannerCacheInit(&server->banners, SERVER_BANNER_CACHE_BYTES);
+    bannerCacheInit(&server->deflatedBanners, SERVER_BANNER_CACHE_BYTES);
+    server->storedBlock = SERVER_NO_OFFSET;
+    server->textMessage = SERVER_NO_OFFSET;
+    server->loop = loop;
+    server->statsSeen = serverStatsGeneration;
+    server->checkpointCursor = loop;
+    server->checkpoints = (CheckpointBatch) {CHECKPOINT_NONE, CHECKPOINT_NONE, 0, 0};
+    sessionPoolInit(&server->sessions);
+    outputPoolInit(&server->output);
+    server->listener = serverListen(config->port, config->threads > 1);
+    server->webListener = (config->webPort != 0) ? serverListen(config->webPort, config->threads > 1) : -1;
+
+    if ((server->listener < 0) || ((config->webPort != 0) && (server->webListener < 0))) {
+        if (server->listener >= 0)
+            close(server->listener);
+
+        free(server);
+        return NULL;}
+
+    server->poller = pollerCreate();
+
+    if ((server->poller < 0) || (pollerWatch(server->poller, server->listener, SESSION_NONE, 0, 1) != 0)
+            || ((server->webListener >= 0) && (pollerWatch(server->poller, server->webListener, SERVER_WEB_LISTENER, 0, 1) != 0))) {
+        perror("Event loop creation failed");
+        close(server->listener);
+
+        if (server->webListener >= 0)
+            close(server->webListener);
+
+        free(server);
+        return NULL;}
+
+    return server;}
+
+int serverRun(const ServerConfig *config) {
+
+    // Loops only run in parallel where the kernel spreads connections over SO_REUSEPORT sockets.
+    if ((config->threads > 1) && !SERVER_REUSEPORT) {
+        fprintf(stderr, "SO_REUSEPORT load balancing is not available, serving with one event loop...\n");
+        ServerConfig single = *config;
+
+        single.threads = 1;
+        return serverRun(&single);}
+
+    metricsEnable();
+
+    // A client that disconnects mid-send must not kill the server.
+    signal(SIGPIPE, SIG_IGN);
+
+    // SIGUSR1 prints the allocator counters; it interrupts the wait instead of restarting it.
+    struct sigaction statsAction = {.sa_handler = serverRequestStats};
+    sigemptyset(&statsAction.sa_mask);
+    sigaction(SIGUSR1, &statsAction, NULL);
+
+    // Loaded, deflated and built once: like the frames, the assets are only read by the loops.
+    static ServerAssets assets;
+
+    if ((assets.font = bannerLoadFont(config->fontPath)) == NULL)
+        fprintf(stderr, "No banner font could be loaded, results are sent as plain text...\n");
+
+    for (int p = 0; (p < 3) && config->compress; p++)
+        for (int c = 0; c < 3; c++) {
+            const RoundFrame *frame = &config->frames[p][c];
+
+            if ((assets.compressedFrames[p][c].data = malloc(DEFLATE_BOUND(frame->lineOffsets[ART_HEIGHT]))) == NULL) {
+                perror("Frame compression failed");
+                return 1;}
+
+            assets.compressedFrames[p][c].length = deflateCompress(frame->text, frame->lineOffsets[ART_HEIGHT], assets.compressedFrames[p][c].data);}
+
+    if ((config->webPort != 0) && (serverBuildPage(&assets, config->frames) != 0))
+        return 1;
+
+    // One mapping shared by every loop: a loop claims records of its own, but any loop may resume any series.
+    static CheckpointFile checkpoint;
+
+    if (config->checkpointPath != NULL) {
+        if (checkpointOpen(&checkpoint, config->checkpointPath, SERVER_CHECKPOINT_RECORDS) != 0) {
+            perror("Could not open the checkpoint file");
+            return 1;}
+
+        assets.checkpoint = &checkpoint;}
+
+    // Every loop's socket is bound before any loop starts, so the port is complete once serving is announced.
+    Server **servers = calloc((size_t) config->threads, sizeof *servers);
+
+    if (servers == NULL) {
+        perror("Server allocation failed");
+        return 1;}
+
+    for (int i = 0; i < config->threads; i++)
+        if ((servers[i] = serverCreate(config, &assets, (unsigned) i)) == NULL)
+            return 1;
+
+    printf("Serving Stone-Paper-Scissors on port %u with %i event loop%s (%zu bytes per session, send SIGUSR1 or the name '/metrics' for counters)...\n",
+        (unsigned) config->port, config->threads, (config->threads > 1) ? "s" : "", sessionBytesPerSession());
+
+    if (config->webPort != 0)
+        printf("Serving the browser client on http://localhost:%u/...\n", (unsigned) config->webPort);
+
+    if (assets.checkpoint != NULL) {
+        uint32_t live = 0;
+
+        for (uint32_t i = 0; i < checkpointUsed(&checkpoint); i++)
+            live += (checkpointRecord(&checkpoint, i)->live != 0);
+
+        printf("Checkpointing series in %s: %u of %u records hold a series to resume (name '/resume CODE')...\n",
+            config->checkpointPath, live, checkpoint.records);}
+    fflush(stdout);
+
+    // Loop 0 runs on this thread with the stream main() seeded; the others get threads and streams of their own.
+    for (int i = 1; i < config->threads; i++) {
+        pthread_t thread;
+
+        if ((pthread_create(&thread, NULL, serverLoopMain, servers[i]) != 0) || (pthread_detach(thread) != 0)) {
+            perror("Could not start an event loop");
+            return 1;}}
+
+    serverLoop(servers[0]);
+
+    return 1;}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-server.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Network game server ('--serve'): plays many concurrent
+ * best-of games over TCP from epoll (Linux) or kqueue (BSD, macOS) event
+ * loops, one per thread, each with its own SO_REUSEPORT listening socket.
+ */
+
+#ifndef SPS_SERVER_H
+#define SPS_SERVER_H
+
+# include <stdint.h>    // Fixed-width integer types (uint64_t) for the seed
+# include "sps-engine.h"    // Random number generator kinds
+# include "sps-terminal.h"  // RoundFrame
+
+// Data types
+/**
+ * @brief Everything the server needs from the command line and the game.
+ */
+typedef struct {
+    unsigned short port;                // TCP port to listen on
+    const RoundFrame (*frames)[3];      // The nine pre-rendered round frames, shared by every session
+    const char *fontPath;               // figlet font file for the final banner, or NULL for the built-in font
+    int bannerWidth;                    // Width the final banner is wrapped at
+    int threads;                        // Event loops, each on its own thread and listening socket
+    RngKind rngKind;                    // Generator of the loops' random streams
+    uint64_t seed;                      // Seed of the loops' random streams (loop i uses stream i)
+    int compress;                       // Non-zero to offer telnet clients MCCP2 compression
+    unsigned short webPort;             // TCP port of the browser client and its WebSocket, or 0
+    const char *checkpointPath;         // Checkpoint file of the series in progress ('--checkpoint'), or NULL
+} ServerConfig;
+
+// Function prototypes
+/**
+ * @brief Runs the game server until the listening socket fails.
+ *
+ * Every connection plays the same game as the interactive mode, without
+ * the delays: name, 'Best of', then choices until one side has won the
+ * series, which ends with the result banner and the connection being
+ * closed. Input is read line by line (a trailing carriage return is
+ * ignored) and validated exactly like the interactive game.
+ *
+ * With more than one loop, every loop binds its own SO_REUSEPORT socket to
+ * the port and the kernel spreads new connections over them; a loop keeps
+ * its sessions, pools, random stream and latency histograms to itself, and
+ * '/metrics' reports the loop that served it. Where the kernel does not
+ * balance SO_REUSEPORT sockets, the server falls back to a single loop.
+ * Loop 0 runs on the calling thread with its default random stream.
+ *
+ * With compress set, every connection is offered MCCP2 (telnet option 86)
+ * and telnet commands are removed from the input. Once a client accepts,
+ * its output is a zlib stream spliced together without a compressor per
+ * session: the nine frames are deflated once at startup and sent by
+ * reference, banners are deflated once per cache entry, and the rest of
+ * the text goes in stored blocks.
+ *
+ * With a webPort, every loop also listens there for browsers: "GET /" is
+ * answered with a page that embeds the nine frames, and a WebSocket
+ * handshake on "/" starts a game. Its prompts and results arrive as text
+ * messages (coalesced per input), and each round as one binary message
+ * with both choices, the scores and the interactive game's timing hints,
+ * which the page draws and animates itself.
+ *
+ * With a checkpointPath, every telnet series is played in a record of the
+ * shared, memory-mapped checkpoint file, and the player is given its resume
+ * code once the series starts. A player who reconnects, to this server or
+ * to one restarted on the same file, sends "/resume CODE" as the name and
+ * continues the series where it stopped. The loops hand the records their
+ * events changed to msync once per batch of events.
+ *
+ * @param config Pointer to the server configuration.
+ * @return 1 if the server could not be started or its event loop failed.
+ */
+int serverRun(const ServerConfig *config);
+
+#endif
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-session.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Slab pool of server sessions and pool of pending output blocks.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdlib.h>    // Standard library functions (malloc)
+# include <string.h>    // String manipulation functions (memset, memcpy)
+# include <errno.h> // Error numbers (EINTR, EAGAIN)
+# include <sys/uio.h>   // Scatter/gather I/O (writev, struct iovec)
+# include "sps-session.h"   // Session types and prototypes
+
+// Define constants for the output queue
+#define OUTPUT_SEND_SEGMENTS 64 // Segments handed to one writev call.
+
+void sessionPoolInit(SessionPool *pool) {
+
+    memset(pool, 0, sizeof *pool);
+    pool->freeList = SESSION_NONE;}
+
+/**
+ * @brief Adds a slab to the pool and threads its sessions onto the free list; returns -1 on failure.
+ */
+static int sessionPoolGrow(SessionPool *pool) {
+
+    if (pool->stats.slabs == SESSION_MAX_SLABS)
+        return -1;
+
+    SessionSlab *slab = malloc(sizeof *slab);
+
+    if (slab == NULL)
+        return -1;
+
+    uint32_t base = (uint32_t) pool->stats.slabs << SESSION_SLAB_SHIFT;
+
+    for (uint32_t i = 0; i < SESSION_SLAB_SIZE; i++)
+        slab->nextFree[i] = (i + 1 < SESSION_SLAB_SIZE) ? base + i + 1 : pool->freeList;
+
+    pool->slabs[pool->stats.slabs++] = slab;
+    pool->stats.capacity += SESSION_SLAB_SIZE;
+    pool->freeList = base;
+
+    return 0;}
+
+uint32_t sessionAcquire(SessionPool *pool) {
+
+    if ((pool->freeList == SESSION_NONE) && (sessionPoolGrow(pool) != 0))
+        return SESSION_NONE;
+
+    uint32_t id = pool->freeList;
+    SessionSlab *slab = sessionSlab(pool, id);
+    uint32_t slot = sessionSlot(id);
+
+    pool->freeList = slab->nextFree[slot];
+
+    memset(&slab->sessions[slot], 0, sizeof slab->sessions[slot]);
+    slab->sessions[slot].state = SESSION_NAME;
+    slab->sessions[slot].outputHead = SESSION_NONE;
+    slab->sessions[slot].outputTail = SESSION_NONE;
+    slab->playerWins[slot] = 0;
+    slab->computerWins[slot] = 0;
+    slab->winsNeeded[slot] = 0;
+
+    pool->stats.acquired++;
+
+    if (++pool->stats.inUse > pool->stats.peak)
+        pool->stats.peak = pool->stats.inUse;
+
+    return id;}
+
+void sessionRelease(SessionPool *pool, uint32_t id) {
+
+    sessionSlab(pool, id)->nextFree[sessionSlot(id)] = pool->freeList;
+    pool->freeList = id;
+    pool->stats.inUse--;
+    pool->stats.released++;}
+
+size_t sessionBytesPerSession(void) {
+
+    return sizeof(SessionSlab) / SESSION_SLAB_SIZE;}
+
+void outputPoolInit(OutputBlockPool *pool) {
+
+    memset(pool, 0, sizeof *pool);
+    pool->freeList = SESSION_NONE;}
+
+/**
+ * @brief Returns an output block by index.
+ */
+static OutputBlock *outputBlockAt(const OutputBlockPool *pool, uint32_t id) {
+
+    return &pool->slabs[id / OUTPUT_BLOCKS_PER_SLAB][id % OUTPUT_BLOCKS_PER_SLAB];}
+
+/**
+ * @brief Takes an empty block from the pool, adding a slab if none is left; returns SESSION_NONE on failure.
+ */
+static uint32_t outputBlockAcquire(OutputBlockPool *pool) {
+
+    if (pool->freeList == SESSION_NONE) {
+
+        if (pool->slabCount == OUTPUT_MAX_SLABS)
+            return SESSION_NONE;
+
+        OutputBlock *slab = malloc(OUTPUT_BLOCKS_PER_SLAB * sizeof *slab);
+
+        if (slab == NULL)
+            return SESSION_NONE;
+
+        uint32_t base = (uint32_t) pool->slabCount * OUTPUT_BLOCKS_PER_SLAB;
+
+        for (uint32_t i = 0; i < OUTPUT_BLOCKS_PER_SLAB; i++)
+            slab[i].next = (i + 1 < OUTPUT_BLOCKS_PER_SLAB) ? base + i + 1 : SESSION_NONE;
+
+        pool->slabs[pool->slabCount++] = slab;
+        pool->freeList = base;}
+
+    uint32_t id = pool->freeList;
+    OutputBlock *block = outputBlockAt(pool, id);
+
+    pool->freeList = block->next;
+    pool->inUse++;
+    block->next = SESSION_NONE;
+    block->first = 0;
+    block->count = 0;
+    block->textLength = 0;
+
+    return id;}
+
+/**
+ * @brief Returns the first block of a session's chain to the pool.
+ */
+static void outputBlockReleaseHead(OutputBlockPool *pool, Session *session) {
+
+    uint32_t id = session->outputHead;
+    OutputBlock *block = outputBlockAt(pool, id);
+
+    session->outputHead = block->next;
+
+    if (session->outputHead == SESSION_NONE)
+        session->outputTail = SESSION_NONE;
+
+    block->next = pool->freeList;
+    pool->freeList = id;
+    pool->inUse--;}
+
+/**
+ * @brief Returns the tail block of a session's chain with room for one more segment, adding a block if needed.
+ *
+ * @param textNeeded Non-zero if the segment will also need room for copied text.
+ */
+static OutputBlock *outputTailBlock(OutputBlockPool *pool, Session *session, int textNeeded) {
+
+    OutputBlock *tail = (session->outputTail != SESSION_NONE) ? outputBlockAt(pool, session->outputTail) : NULL;
+
+    if ((tail != NULL) && (tail->count < OUTPUT_BLOCK_SEGMENTS) && (!textNeeded || (tail->textLength < sizeof tail->text)))
+        return tail;
+
+    uint32_t id = outputBlockAcquire(pool);
+
+    if (id == SESSION_NONE)
+        return NULL;
+
+    if (tail != NULL)
+        tail->next = id;
+    else
+        session->outputHead = id;
+
+    session->outputTail = id;
+
+    return outputBlockAt(pool, id);}
+
+int sessionQueueOutput(OutputBlockPool *pool, Session *session, const char *data, size_t length) {
+
+    while (length > 0) {
+
+        OutputBlock *tail = (session->outputTail != SESSION_NONE) ? outputBlockAt(pool, session->outputTail) : NULL;
+        OutputSegment *last = ((tail != NULL) && (tail->count > tail->first)) ? &tail->segments[tail->count - 1] : NULL;
+
+        // Text following text copied just before extends the same segment.
+        if ((last == NULL) || (last->data + last->length != tail->text + tail->textLength) || (tail->textLength == sizeof tail->text)) {
+
+            tail = outputTailBlock(pool, session, 1);
+
+            if (tail == NULL)
+                return -1;
+
+            last = &tail->segments[tail->count++];
+            last->data = tail->text + tail->textLength;
+            last->length = 0;}
+
+        size_t room = sizeof tail->text - tail->textLength;
+        size_t chunk = (length < room) ? length : room;
+
+        memcpy(tail->text + tail->textLength, data, chunk);
+        tail->textLength += (uint32_t) chunk;
+        last->length += chunk;
+        data += chunk;
+        length -= chunk;}
+
+    return 0;}
+
+int sessionQueueShared(OutputBlockPool *pool, Session *session, const char *data, size_t length) {
+
+    if (length == 0)
+        return 0;
+
+    OutputBlock *tail = outputTailBlock(pool, session, 0);
+
+    if (tail == NULL)
+        return -1;
+
+    tail->segments[tail->count++] = (OutputSegment) {data, length};
+
+    return 0;}
+
+int sessionSendOutput(OutputBlockPool *pool, Session *session) {
+
+    while (session->outputHead != SESSION_NONE) {
+
+        struct iovec parts[OUTPUT_SEND_SEGMENTS];
+        int count = 0;
+
+        // Gather the pending segments of as many blocks as fit into one writev.
+        for (uint32_t id = session->outputHead; (id != SESSION_NONE) && (count < OUTPUT_SEND_SEGMENTS); ) {
+
+            OutputBlock *block = outputBlockAt(pool, id);
+
+            for (int i = block->first; (i < block->count) && (count < OUTPUT_SEND_SEGMENTS); i++, count++) {
+                parts[count].iov_base = (void *) block->segments[i].data;
+                parts[count].iov_len = block->segments[i].length;}
+
+            id = block->next;}
+
+        ssize_t sent = (count > 0) ? writev(session->descriptor, parts, count) : 0;
+
+        if (sent < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 1 : -1;}
+
+        // Drop every segment sent in full, advance into the first partial one and release emptied blocks.
+        while (session->outputHead != SESSION_NONE) {
+
+            OutputBlock *block = outputBlockAt(pool, session->outputHead);
+
+            while ((block->first < block->count) && ((size_t) sent >= block->segments[block->first].length)) {
+                sent -= (ssize_t) block->segments[block->first].length;
+                block->first++;}
+
+            if (block->first < block->count) {
+                block->segments[block->first].data += sent;
+                block->segments[block->first].length -= (size_t) sent;
+                break;}
+
+            outputBlockReleaseHead(pool, session);}}
+
+    return 0;}
+
+void sessionDropOutput(OutputBlockPool *pool, Session *session) {
+
+    while (session->outputHead != SESSION_NONE)
+        outputBlockReleaseHead(pool, session);}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-session.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Storage of the server's per-connection game state. Sessions
+ * live in a slab pool addressed by index, with the hot counters kept as
+ * structure-of-arrays inside each slab, and output a socket did not accept
+ * yet waits in fixed-size blocks from a second pool. Pending output is a
+ * list of segments: text is copied into the blocks, while shared immutable
+ * data (the round frames) is only referenced. Both pools recycle their
+ * entries through O(1) free lists, so connection churn does not call malloc
+ * once the pools have grown to the peak load.
+ */
+
+#ifndef SPS_SESSION_H
+#define SPS_SESSION_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint8_t, uint32_t, int32_t)
+# include "sps-engine.h"    // MAX_PLAYER_NAME and ChoiceTokenizer
+# include "sps-websocket.h" // WebSocket frame decoder of browser sessions
+
+// Define constants for the session pool
+#define SESSION_SLAB_SHIFT 10   // log2 of the number of sessions per slab.
+#define SESSION_SLAB_SIZE (1 << SESSION_SLAB_SHIFT) // Sessions per slab.
+#define SESSION_MAX_SLABS 1024  // Slabs the pool can grow to (a million sessions).
+#define SESSION_NONE UINT32_MAX // Index that refers to no session (or no output block).
+#define SESSION_LINE_BUFFER 32  // Bytes of an input line kept (longer lines are truncated, like fgets).
+#define OUTPUT_BLOCK_SIZE 4096  // Size of one output block, header included.
+#define OUTPUT_BLOCK_SEGMENTS 32    // Segments of pending output one block describes.
+#define OUTPUT_BLOCKS_PER_SLAB 64   // Output blocks allocated at a time.
+#define OUTPUT_MAX_SLABS 4096   // Slabs the output pool can grow to (1 GiB of pending output).
+
+// Data types
+/**
+ * @brief Where a session is in the game.
+ */
+typedef enum {
+    SESSION_NAME = 0,   // Waiting for the player's name
+    SESSION_BEST_OF,    // Waiting for the 'Best of' number
+    SESSION_CHOICE,     // Waiting for a Stone/Paper/Scissors choice
+    SESSION_HTTP,       // Reading the request of a browser, before the WebSocket handshake
+    SESSION_CLOSING     // Game over: sending the last output, then closing
+} SessionState;
+
+/**
+ * @brief Per-connection state that is not a counter: what main() keeps in locals for the interactive game.
+ */
+typedef struct {
+    char playerName[MAX_PLAYER_NAME];   // Player's name
+    union {
+        char line[SESSION_LINE_BUFFER]; // Input line being received (name and 'Best of')
+        ChoiceTokenizer choice;         // Choice being received (SESSION_CHOICE)
+        struct {
+            char key[WEBSOCKET_KEY_LENGTH]; // Sec-WebSocket-Key header
+            uint8_t keyLength;              // Characters of key received
+            uint8_t column;                 // Bytes of the current line received (up to 255)
+            uint8_t matching;               // Non-zero while the current line can still be the request line or the key header
+            uint8_t lines;                  // Lines received (up to 255); the first is the request line
+            uint8_t root;                   // Non-zero if the request line asked for "/"
+        } request;                          // HTTP request being received (SESSION_HTTP)
+    };
+    int descriptor;                     // Connected socket
+    uint32_t outputHead;                // First block of output not yet accepted by the socket, or SESSION_NONE
+    uint32_t outputTail;                // Last block of pending output
+    uint8_t lineLength;                 // Bytes in line
+    uint8_t state;                      // Step of the game (a SessionState)
+    uint8_t writing;                    // Non-zero while waiting for the socket to accept more output
+    uint8_t telnet;                     // Part of a telnet command being received (a TelnetState of the server)
+    uint8_t compressed;                 // Non-zero once the output is an MCCP2 deflate stream
+    uint8_t websocket;                  // Non-zero once the connection speaks WebSocket (2 after the close frame, 3 once it is sent and the browser's is awaited)
+    WebSocketReader reader;             // Frames being received from a WebSocket client
+    uint32_t checkpoint;                // Record of the session's series in the checkpoint file, or CHECKPOINT_NONE
+} Session;
+
+/**
+ * @brief SESSION_SLAB_SIZE sessions, with the counters updated every round stored as separate arrays.
+ */
+typedef struct {
+    Session sessions[SESSION_SLAB_SIZE];
+    int32_t playerWins[SESSION_SLAB_SIZE];      // Rounds won by the player
+    int32_t computerWins[SESSION_SLAB_SIZE];    // Rounds won by the computer
+    int32_t winsNeeded[SESSION_SLAB_SIZE];      // Wins required to win the series ('n' in main)
+    uint32_t nextFree[SESSION_SLAB_SIZE];       // Free list link of each unused session
+} SessionSlab;
+
+/**
+ * @brief Allocator counters of a session pool.
+ */
+typedef struct {
+    long long slabs;            // Slabs allocated
+    long long capacity;         // Sessions the allocated slabs hold
+    long long inUse;            // Sessions currently acquired
+    long long peak;             // Highest number of sessions acquired at once
+    long long acquired;         // Total sessionAcquire calls that succeeded
+    long long released;         // Total sessionRelease calls
+} SessionPoolStats;
+
+/**
+ * @brief Slab pool of sessions addressed by index.
+ */
+typedef struct {
+    SessionSlab *slabs[SESSION_MAX_SLABS];  // Allocated slabs; index i lives in slabs[i >> SESSION_SLAB_SHIFT]
+    uint32_t freeList;                      // First unused session, or SESSION_NONE
+    SessionPoolStats stats;
+} SessionPool;
+
+/**
+ * @brief A contiguous run of pending output bytes.
+ */
+typedef struct {
+    const char *data;   // First unsent byte (inside the block for copied text, or in shared memory)
+    size_t length;      // Unsent bytes
+} OutputSegment;
+
+/**
+ * @brief A block of pending output, chained per session: a list of segments plus room for copied text.
+ */
+typedef struct {
+    OutputSegment segments[OUTPUT_BLOCK_SEGMENTS];
+    uint32_t next;          // Next block of the chain (or of the free list), or SESSION_NONE
+    uint16_t first;         // First unsent segment
+    uint16_t count;         // Segments used
+    uint32_t textLength;    // Bytes of text used
+    char text[OUTPUT_BLOCK_SIZE - OUTPUT_BLOCK_SEGMENTS * sizeof(OutputSegment) - 3 * sizeof(uint32_t)];   // Copied text the segments point into
+} OutputBlock;
+
+/**
+ * @brief Pool of output blocks addressed by index.
+ */
+typedef struct {
+    OutputBlock *slabs[OUTPUT_MAX_SLABS];   // Allocated slabs of OUTPUT_BLOCKS_PER_SLAB blocks
+    uint32_t freeList;                      // First unused block, or SESSION_NONE
+    long long slabCount;                    // Slabs allocated
+    long long inUse;                        // Blocks holding pending output
+} OutputBlockPool;
+
+// Function prototypes
+/**
+ * @brief Initialises an empty session pool.
+ *
+ * @param pool Pointer to the pool.
+ */
+void sessionPoolInit(SessionPool *pool);
+
+/**
+ * @brief Takes an unused session from the pool, adding a slab if none is left.
+ *
+ * The session is returned zeroed, in state SESSION_NAME, with no pending output.
+ *
+ * @param pool Pointer to the pool.
+ * @return Index of the session, or SESSION_NONE if the pool cannot grow.
+ */
+uint32_t sessionAcquire(SessionPool *pool);
+
+/**
+ * @brief Returns a session to the pool. Its output must have been released first.
+ *
+ * @param pool Pointer to the pool.
+ * @param id Index of the session.
+ */
+void sessionRelease(SessionPool *pool, uint32_t id);
+
+/**
+ * @brief Memory taken by one session slot, idle or not (the slab storage divided by its sessions).
+ */
+size_t sessionBytesPerSession(void);
+
+/**
+ * @brief Initialises an empty output block pool.
+ *
+ * @param pool Pointer to the pool.
+ */
+void outputPoolInit(OutputBlockPool *pool);
+
+/**
+ * @brief Appends a copy of some bytes to a session's pending output.
+ *
+ * @param pool Pointer to the output block pool.
+ * @param session Pointer to the session.
+ * @param data Bytes to append.
+ * @param length Number of bytes.
+ * @return 0 on success, -1 if the pool cannot grow.
+ */
+int sessionQueueOutput(OutputBlockPool *pool, Session *session, const char *data, size_t length);
+
+/**
+ * @brief Appends a reference to shared bytes to a session's pending output, without copying them.
+ *
+ * @param pool Pointer to the output block pool.
+ * @param session Pointer to the session.
+ * @param data Bytes to append; they must stay valid and unchanged until sent (e.g. the round frames).
+ * @param length Number of bytes.
+ * @return 0 on success, -1 if the pool cannot grow.
+ */
+int sessionQueueShared(OutputBlockPool *pool, Session *session, const char *data, size_t length);
+
+/**
+ * @brief Sends as much of a session's pending output as its socket accepts, releasing the blocks sent.
+ *
+ * @param pool Pointer to the output block pool.
+ * @param session Pointer to the session.
+ * @return 0 if everything was sent, 1 if output is still pending, -1 if the connection failed.
+ */
+int sessionSendOutput(OutputBlockPool *pool, Session *session);
+
+/**
+ * @brief Releases all pending output of a session without sending it.
+ *
+ * @param pool Pointer to the output block pool.
+ * @param session Pointer to the session.
+ */
+void sessionDropOutput(OutputBlockPool *pool, Session *session);
+
+/**
+ * @brief Returns the slab holding a session.
+ */
+static inline SessionSlab *sessionSlab(const SessionPool *pool, uint32_t id) {
+
+    return pool->slabs[id >> SESSION_SLAB_SHIFT];}
+
+/**
+ * @brief Returns the position of a session inside its slab (the index into the counter arrays).
+ */
+static inline uint32_t sessionSlot(uint32_t id) {
+
+    return id & (SESSION_SLAB_SIZE - 1);}
+
+/**
+ * @brief Returns the non-counter state of a session.
+ */
+static inline Session *sessionAt(const SessionPool *pool, uint32_t id) {
+
+    return &sessionSlab(pool, id)->sessions[sessionSlot(id)];}
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-stats.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Offline analyzer of binary match logs written with '--log'.
+ * Every log is memory-mapped and scanned once; round bytes are counted in a
+ * histogram indexed by the byte itself, so the per-round work is a single
+ * increment, and the win rates and move distributions are derived from the
+ * histogram at the end.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (printf, fprintf, perror)
+# include <string.h>    // String manipulation functions (strcmp, memchr, memcmp)
+# include <time.h>  // Time functions (clock_gettime) for the scan rate
+# include <unistd.h>    // POSIX operating system API (close)
+# include <fcntl.h> // POSIX file control (open)
+# include <sys/mman.h>  // POSIX memory mapping (mmap, madvise) for the logs
+# include <sys/stat.h>  // POSIX file status (fstat) for sizing the mappings
+# include "sps-engine.h"    // ROUND_* outcomes
+# include "sps-log.h"   // Match log format and reader
+
+// Define constants for the analyzer
+#define STATS_HISTOGRAMS 4  // Histograms filled in turn, so consecutive equal bytes do not wait on each other's increment.
+#define STATS_ROUND_VALUES 64   // Distinct round bytes (choice | choice << 2 | outcome << 4).
+
+// Data types
+/**
+ * @brief Counters of every log scanned.
+ */
+typedef struct {
+    long long files;            // Logs scanned
+    long long bytes;            // Bytes scanned
+    long long decided;          // Matches one side won
+    long long abandoned;        // Matches that stopped early
+    long long playerMatches;    // Decided matches won by the player
+    long long skipped;          // Bytes skipped because they were not a complete match
+    unsigned long long rounds[STATS_HISTOGRAMS][STATS_ROUND_VALUES];    // Round bytes seen, by value
+} LogStats;
+
+/**
+ * @brief Counts the round bytes of one match.
+ */
+static void statsCountRounds(LogStats *stats, const uint8_t *rounds, size_t count) {
+
+    size_t i = 0;
+
+    for (; i + STATS_HISTOGRAMS <= count; i += STATS_HISTOGRAMS)
+        for (int h = 0; h < STATS_HISTOGRAMS; h++)
+            stats->rounds[h][rounds[i + h] & (STATS_ROUND_VALUES - 1)]++;
+
+    for (; i < count; i++)
+        stats->rounds[0][rounds[i] & (STATS_ROUND_VALUES - 1)]++;}
+
+/**
+ * @brief Returns the offset of the first match header at or after start, or size if there is none.
+ */
+static size_t statsFindHeader(const uint8_t *data, size_t size, size_t start) {
+
+    while (start + MATCH_LOG_MAGIC_LENGTH <= size) {
+
+        const uint8_t *candidate = memchr(data + start, MATCH_LOG_MAGIC[0], size - start);
+
+        if (candidate == NULL)
+            break;
+
+        start = (size_t) (candidate - data);
+
+        if ((start + MATCH_LOG_MAGIC_LENGTH <= size) && (memcmp(candidate, MATCH_LOG_MAGIC, MATCH_LOG_MAGIC_LENGTH) == 0))
+            return start;
+
+        start++;}
+
+    return size;}
+
+/**
+ * @brief Scans one mapped log.
+ */
+static void statsScan(LogStats *stats, const uint8_t *data, size_t size) {
+
+    size_t offset = 0;
+
+    while (offset < size) {
+
+        MatchLogRecord record;
+        size_t length = matchLogParse(data + offset, size - offset, &record);
+
+        // Not a complete match (e.g. a crash cut the log short): resume at the next header.
+        if (length == 0) {
+            size_t resume = statsFindHeader(data, size, offset + 1);
+
+            stats->skipped += (long long) (resume - offset);
+            offset = resume;
+            continue;}
+
+        statsCountRounds(stats, record.rounds, record.roundCount);
+
+        // The last round of a decided match is the one that won it.
+        if (record.decided && (record.roundCount > 0)) {
+            stats->decided++;
+            stats->playerMatches += ((record.rounds[record.roundCount - 1] >> 4) == ROUND_PLAYER_WINS);}
+
+        else
+            stats->abandoned++;
+
+        offset += length;}}
+
+/**
+ * @brief Maps and scans one log file; returns 1 if it could not be read.
+ */
+static int statsScanFile(LogStats *stats, const char *path) {
+
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+
+    if ((fd < 0) || (fstat(fd, &info) != 0)) {
+        fprintf(stderr, "Could not open '%s'...\n", path);
+
+        if (fd >= 0)
+            close(fd);
+
+        return 1;}
+
+    size_t size = (size_t) info.st_size;
+    void *data = (size > 0) ? mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        fprintf(stderr, "Could not map '%s'...\n", path);
+        return 1;}
+
+    if (size > 0) {
+        madvise(data, size, MADV_SEQUENTIAL);  // Read once, front to back
+        statsScan(stats, data, size);
+        munmap(data, size);}
+
+    stats->files++;
+    stats->bytes += (long long) size;
+
+    return 0;}
+
+/**
+ * @brief Returns part as a percentage of whole (0 if whole is 0).
+ */
+static double percent(unsigned long long part, unsigned long long whole) {
+
+    return (whole > 0) ? 100.0 * (double) part / (double) whole : 0.0;}
+
+/**
+ * @brief Prints the report of every log scanned.
+ */
+static void statsPrint(const LogStats *stats, double elapsed) {
+
+    static const char *choiceNames[3] = {"Stone", "Paper", "Scissors"};
+    unsigned long long outcomes[3] = {0}, playerMoves[3] = {0}, computerMoves[3] = {0}, playerMoveWins[3] = {0};
+    unsigned long long total = 0;
+
+    // Fold the histograms into outcome and move counts.
+    for (int h = 0; h < STATS_HISTOGRAMS; h++)
+        for (int value = 0; value < STATS_ROUND_VALUES; value++) {
+
+            unsigned long long count = stats->rounds[h][value];
+            int player = value & 3, computer = (value >> 2) & 3, outcome = value >> 4;
+
+            if ((count == 0) || (player == 0) || (computer == 0) || (outcome > ROUND_COMPUTER_WINS))
+                continue;
+
+            total += count;
+            outcomes[outcome] += count;
+            playerMoves[player - 1] += count;
+            computerMoves[computer - 1] += count;
+            playerMoveWins[player - 1] += (outcome == ROUND_PLAYER_WINS) ? count : 0;}
+
+    long long matches = stats->decided + stats->abandoned;
+
+    printf("Logs scanned      : %lld (%lld bytes, %lld skipped)\n", stats->files, stats->bytes, stats->skipped);
+    printf("Matches           : %lld (%lld decided, %lld abandoned)\n", matches, stats->decided, stats->abandoned);
+    printf("Player matches    : %lld (%.2f%% of decided)\n", stats->playerMatches, percent((unsigned long long) stats->playerMatches, (unsigned long long) stats->decided));
+    printf("Computer matches  : %lld (%.2f%% of decided)\n", stats->decided - stats->playerMatches, percent((unsigned long long) (stats->decided - stats->playerMatches), (unsigned long long) stats->decided));
+    printf("Rounds            : %llu\n", total);
+    printf("Player rounds     : %llu (%.2f%%)\n", outcomes[ROUND_PLAYER_WINS], percent(outcomes[ROUND_PLAYER_WINS], total));
+    printf("Computer rounds   : %llu (%.2f%%)\n", outcomes[ROUND_COMPUTER_WINS], percent(outcomes[ROUND_COMPUTER_WINS], total));
+    printf("Tied rounds       : %llu (%.2f%%)\n", outcomes[ROUND_TIE], percent(outcomes[ROUND_TIE], total));
+
+    printf("\nMove       Player            Computer          Player win rate\n");
+
+    for (int i = 0; i < 3; i++)
+        printf("%-10s %-9llu %6.2f%%  %-9llu %6.2f%%  %6.2f%%\n", choiceNames[i], playerMoves[i], percent(playerMoves[i], total),
+            computerMoves[i], percent(computerMoves[i], total), percent(playerMoveWins[i], playerMoves[i]));
+
+    printf("\nElapsed seconds   : %.6f\n", elapsed);
+    printf("Scan rate         : %.1f MB/s\n", (elapsed > 0) ? (double) stats->bytes / elapsed / 1e6 : 0.0);}
+
+int main(int argc, char *argv[]) {
+
+    if ((argc < 2) || (strcmp(argv[1], "-h") == 0) || (strcmp(argv[1], "--help") == 0)) {
+        fprintf((argc < 2) ? stderr : stdout, "Usage: %s LOG...\n\nReports win rates and move distributions of match logs written with '--log'.\n", argv[0]);
+        return (argc < 2) ? 1 : 0;}
+
+    static LogStats stats;  // Zero-initialised
+    struct timespec start, end;
+    int status = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 1; i < argc; i++)
+        status |= statsScanFile(&stats, argv[i]);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    statsPrint(&stats, (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9);
+
+    return status;}
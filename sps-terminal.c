@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-terminal.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: The game's terminal: the output buffer, the animation scheduler,
+ * buffered player input and the pre-rendered round frames.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (vsnprintf, EOF)
+# include <stdlib.h>    // Standard library functions (realloc, strtol, getenv)
+# include <string.h>    // String manipulation functions (strlen, memcpy, memchr, strcmp)
+# include <time.h>  // Time functions (clock_gettime) for the animation deadlines
+# include <unistd.h>    // POSIX operating system API (read, write, isatty)
+# include <poll.h>  // POSIX poll() to read stdin while animations are scheduled
+# include <errno.h> // Error numbers (EINTR, ERANGE, ENOENT)
+# include <limits.h>    // Integer limits (INT_MIN, INT_MAX)
+# include <stdarg.h>    // Variable arguments (va_list) for animationPrintf
+# include <sys/mman.h>  // POSIX memory mapping (mmap, mprotect) for the frame region
+# include <sys/ioctl.h> // Terminal size (ioctl, TIOCGWINSZ) for the in-place frames
+# include "sps-metrics.h"   // Phase timing
+# include "sps-terminal.h"  // Terminal types and prototypes
+
+// Define constants for the terminal buffers
+#define INPUT_BUFFER_SIZE 4096  // Bytes of type-ahead input kept while animations run.
+#define INPUT_INTEGER_BUFFER 32 // Line buffer used to read the 'Best of' integer.
+#define ANIMATION_PRINTF_BUFFER 256 // Longest formatted chunk queued by animationPrintf.
+#define OUTPUT_BUFFER_SIZE 65536    // Size of the game's stdout buffer.
+#define FRAME_SEQUENCE_BUFFER 64    // Longest cursor sequence of the in-place frames.
+#define FRAME_SPAN_GAP 8    // Equal columns that end a changed span (fewer are redrawn instead of skipped).
+#define FRAME_MIN_SCROLL_ROWS 6 // Rows below the in-place frame left for the prompts to scroll in.
+
+// Data types
+/**
+ * @brief One entry of the animation queue: a pause followed by a slice of output.
+ */
+typedef struct {
+    size_t offset;      // Start of the chunk's bytes in the scheduler's text arena
+    size_t length;      // Number of bytes to write (0 for a pure pause)
+    unsigned delay;     // Microseconds to wait before writing the bytes
+} AnimationChunk;
+
+// In-place drawing of the round frames (see framesInPlaceEnable).
+static struct {
+    int enabled;                // Non-zero once the terminal was found able to hold a fixed frame
+    int rows;                   // Height of the terminal
+    const RoundFrame *shown;    // Frame on the screen, or NULL before the first round
+} framesInPlace;
+
+/**
+ * @brief Queues the spans of one frame line that differ from the line on the screen, each after a cursor move.
+ *
+ * Equal runs shorter than FRAME_SPAN_GAP are redrawn rather than jumped
+ * over, since a cursor move costs about as much; a line that got shorter
+ * is cleared from its new end.
+ *
+ * @return Non-zero if anything was queued.
+ */
+static int framesDiffLine(const char *old, size_t oldLength, const char *line, size_t length, int row) {
+
+    char move[FRAME_SEQUENCE_BUFFER];
+    size_t column = 0;
+    int changed = 0;
+
+    while (column < length) {
+
+        if ((column < oldLength) && (old[column] == line[column])) {
+            column++;
+            continue;}
+
+        // A span ends at the first run of FRAME_SPAN_GAP equal columns (or at the end of the line).
+        size_t end = column + 1, equal = 0;
+
+        for (; (end < length) && (equal < FRAME_SPAN_GAP); end++)
+            equal = ((end < oldLength) && (old[end] == line[end])) ? equal + 1 : 0;
+
+        end -= equal;
+
+        int moveLength = snprintf(move, sizeof move, "\x1b[%i;%zuH", row, column + 1);
+
+        animationWrite(move, (size_t) moveLength);
+        animationWrite(line + column, end - column);
+        changed = 1;
+        column = end;}
+
+    if (oldLength > length) {
+        int moveLength = snprintf(move, sizeof move, "\x1b[%i;%zuH\x1b[K", row, length + 1);
+
+        animationWrite(move, (size_t) moveLength);
+        changed = 1;}
+
+    return changed;}
+
+/**
+ * @brief Draws a frame over the one on the screen, changed spans only.
+ *
+ * The first frame clears the screen, is drawn at the top and confines
+ * scrolling to the rows below it, where the prompts and scores go on.
+ */
+static void framesDrawInPlace(const RoundFrame *frame) {
+
+    const RoundFrame *shown = framesInPlace.shown;
+    char sequence[FRAME_SEQUENCE_BUFFER];
+
+    if (shown == NULL) {
+        animationWrite("\x1b[H\x1b[2J", 7);
+
+        for (int i = 0; i < ART_HEIGHT; i++) {
+            animationWrite(frame->text + frame->lineOffsets[i], frame->lineOffsets[i + 1] - frame->lineOffsets[i]);
+            animationDelay(UI_MICRO_DELAY_SHORT);}
+
+        // Setting the scrolling region homes the cursor: move it back below the frame.
+        int length = snprintf(sequence, sizeof sequence, "\x1b[%i;%ir\x1b[%i;1H", ART_HEIGHT + 2, framesInPlace.rows, ART_HEIGHT + 2);
+
+        animationWrite(sequence, (size_t) length);
+        framesInPlace.shown = frame;
+        return;}
+
+    // The cursor is saved in the scrolling region and put back after the frame.
+    animationWrite("\x1b" "7", 2);
+
+    // Only lines that changed are drawn, so only they keep the line-by-line delay.
+    for (int i = 0; i < ART_HEIGHT; i++) {
+
+        // Lines are compared without their newline.
+        const char *old = shown->text + shown->lineOffsets[i], *line = frame->text + frame->lineOffsets[i];
+        size_t oldLength = shown->lineOffsets[i + 1] - shown->lineOffsets[i] - 1, length = frame->lineOffsets[i + 1] - frame->lineOffsets[i] - 1;
+
+        if (framesDiffLine(old, oldLength, line, length, i + 1))
+            animationDelay(UI_MICRO_DELAY_SHORT);}
+
+    animationWrite("\x1b" "8", 2);
+    framesInPlace.shown = frame;}
+
+void asciiArtPrinter(const RoundFrame *frame) {
+
+    uint64_t start = metricsStart();
+
+    if (framesInPlace.enabled)
+        framesDrawInPlace(frame);
+
+    else
+        for(int i = 0; i < ART_HEIGHT; i++) {
+
+            // Print line from first, second and third art side-by-side as one slice
+            animationWrite(frame->text + frame->lineOffsets[i], frame->lineOffsets[i + 1] - frame->lineOffsets[i]);
+            animationDelay(UI_MICRO_DELAY_SHORT);}
+
+    metricsStop(METRIC_RENDER, start);}
+
+int framesInPlaceEnable(const RoundFrame frames[3][3]) {
+
+    const char *term = getenv("TERM");
+    struct winsize size;
+    size_t width = 0;
+
+    for (int p = 0; p < 3; p++)
+        for (int c = 0; c < 3; c++)
+            for (int i = 0; i < ART_HEIGHT; i++) {
+                size_t length = frames[p][c].lineOffsets[i + 1] - frames[p][c].lineOffsets[i] - 1;
+
+                width = (length > width) ? length : width;}
+
+    // A terminal that understands the cursor sequences, high enough for the frame and a few lines below, and wide enough not to wrap it.
+    if (!isatty(STDOUT_FILENO) || (term == NULL) || (term[0] == '\0') || (strcmp(term, "dumb") == 0) || (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0)
+            || (size.ws_row < ART_HEIGHT + FRAME_MIN_SCROLL_ROWS) || (size.ws_col < width))
+        return 0;
+
+    framesInPlace.enabled = 1;
+    framesInPlace.rows = size.ws_row;
+    framesInPlace.shown = NULL;
+
+    return 1;}
+
+void framesInPlaceDisable(void) {
+
+    // The whole screen scrolls again; the cursor stays where the game left it.
+    if (framesInPlace.enabled && (framesInPlace.shown != NULL))
+        animationWrite("\x1b" "7" "\x1b[r" "\x1b" "8", 7);
+
+    framesInPlace.enabled = 0;
+    framesInPlace.shown = NULL;}
+
+int buildRoundFrames(const Art *moveArts[3], const Art *vs, RoundFrame frames[3][3]) {
+
+    size_t frameSize[3][3];
+    size_t total = 0;
+
+    // A NULL art is one artFind could not find: its art/NAME.txt is missing.
+    if ((moveArts[0] == NULL) || (moveArts[1] == NULL) || (moveArts[2] == NULL) || (vs == NULL)) {
+        errno = ENOENT;
+        return -1;}
+
+    for (int p = 0; p < 3; p++)
+        for (int c = 0; c < 3; c++) {
+
+            frameSize[p][c] = ART_HEIGHT;   // One newline per line
+
+            for (int i = 0; i < ART_HEIGHT; i++)
+                frameSize[p][c] += moveArts[p]->lines[i].length + vs->lines[i].length + moveArts[c]->lines[i].length;
+
+            total += frameSize[p][c];}
+
+    // The frames get pages of their own, made read-only once filled; they live until the program exits.
+    char *region = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    char *buffer = region;
+
+    if (region == MAP_FAILED)
+        return -1;
+
+    for (int p = 0; p < 3; p++)
+        for (int c = 0; c < 3; c++) {
+
+            const ArtLine *parts[3] = {moveArts[p]->lines, vs->lines, moveArts[c]->lines};
+            size_t offset = 0;
+
+            frames[p][c].text = buffer;
+
+            for (int i = 0; i < ART_HEIGHT; i++) {
+
+                frames[p][c].lineOffsets[i] = offset;
+
+                for (int k = 0; k < 3; k++) {
+                    memcpy(buffer + offset, parts[k][i].text, parts[k][i].length);
+                    offset += parts[k][i].length;}
+
+                buffer[offset++] = '\n';}
+
+            frames[p][c].lineOffsets[ART_HEIGHT] = offset;
+            buffer += frameSize[p][c];}
+
+    // Sockets may reference the frames until their output is sent, so they must never change.
+    return mprotect(region, total, PROT_READ);}
+
+// Output buffer owned by the game: stdout is only written by outputFlush.
+static struct {
+    char data[OUTPUT_BUFFER_SIZE];
+    size_t length;
+    int descriptor;             // Where the buffer is flushed to (stdout unless redirected)
+} outputBuffer = {.descriptor = STDOUT_FILENO};
+
+/**
+ * @brief Writes all bytes to the output descriptor, retrying after partial writes and interruptions.
+ */
+static void outputWriteAll(const char *data, size_t length) {
+
+    uint64_t start = (length > 0) ? metricsStart() : 0;
+
+    while (length > 0) {
+
+        ssize_t written = write(outputBuffer.descriptor, data, length);
+
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+
+            break;  // stdout is gone; nothing sensible left to do with the output
+        }
+
+        data += written;
+        length -= (size_t) written;}
+
+    metricsStop(METRIC_OUTPUT, start);}
+
+void outputWrite(const char *data, size_t length) {
+
+    if (outputBuffer.length + length > OUTPUT_BUFFER_SIZE) {
+        outputFlush();
+
+        // Too large to buffer at all: hand it to the kernel directly.
+        if (length > OUTPUT_BUFFER_SIZE) {
+            outputWriteAll(data, length);
+            return;}}
+
+    memcpy(outputBuffer.data + outputBuffer.length, data, length);
+    outputBuffer.length += length;}
+
+void outputFlush(void) {
+
+    outputWriteAll(outputBuffer.data, outputBuffer.length);
+    outputBuffer.length = 0;}
+
+void outputSetDescriptor(int descriptor) {
+
+    outputFlush();
+    outputBuffer.descriptor = descriptor;}
+
+// Pending output of the animation scheduler: a text arena plus the chunks that slice it.
+static struct {
+    char *text;                 // Bytes of every queued chunk, back to back
+    size_t textLength;
+    size_t textCapacity;
+    AnimationChunk *chunks;     // Chunks in the order they are written
+    size_t count;
+    size_t capacity;
+} animationQueue;
+
+// Type-ahead buffer: bytes read from stdin while an animation is running.
+static struct {
+    char data[INPUT_BUFFER_SIZE];
+    size_t start;               // First unread byte
+    size_t end;                 // One past the last unread byte
+    int eof;                    // Non-zero once stdin reported end of file or an error
+    int terminal;               // 1 if stdin is a TTY, 0 if not, -1 if not checked yet
+} inputQueue = {.terminal = -1};
+
+/**
+ * @brief Reads whatever stdin has to offer into the type-ahead buffer (blocks if it has nothing).
+ */
+static void inputFill(void) {
+
+    if (inputQueue.start > 0) {
+        memmove(inputQueue.data, inputQueue.data + inputQueue.start, inputQueue.end - inputQueue.start);
+        inputQueue.end -= inputQueue.start;
+        inputQueue.start = 0;}
+
+    if (inputQueue.end == INPUT_BUFFER_SIZE)
+        return;
+
+    ssize_t received = read(STDIN_FILENO, inputQueue.data + inputQueue.end, INPUT_BUFFER_SIZE - inputQueue.end);
+
+    if (received > 0)
+        inputQueue.end += (size_t) received;
+
+    else if ((received == 0) || (errno != EINTR))
+        inputQueue.eof = 1;}
+
+/**
+ * @brief Returns non-zero if the player typed a complete line ahead on a terminal.
+ *
+ * Piped or redirected input is always "ahead", so it never skips animations.
+ */
+static int inputSkipsAnimation(void) {
+
+    if (inputQueue.terminal < 0)
+        inputQueue.terminal = isatty(STDIN_FILENO);
+
+    return inputQueue.terminal && (memchr(inputQueue.data + inputQueue.start, '\n', inputQueue.end - inputQueue.start) != NULL);}
+
+/**
+ * @brief Waits for the given time while reading stdin into the type-ahead buffer.
+ *
+ * Returns early as soon as the player has typed a complete line ahead.
+ */
+static void animationWait(unsigned microseconds) {
+
+    struct timespec now, deadline;
+    uint64_t start = metricsStart();
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += microseconds / 1000000;
+    deadline.tv_nsec += (long) (microseconds % 1000000) * 1000;
+
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;}
+
+    while (!inputSkipsAnimation()) {
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        long long remaining = (long long) (deadline.tv_sec - now.tv_sec) * 1000000000LL + (deadline.tv_nsec - now.tv_nsec);
+
+        if (remaining <= 0)
+            break;
+
+        // Only watch stdin while there is something to read and room to store it.
+        struct pollfd input = {.fd = (inputQueue.eof || (inputQueue.end - inputQueue.start == INPUT_BUFFER_SIZE)) ? -1 : STDIN_FILENO, .events = POLLIN};
+
+        if ((poll(&input, 1, (int) ((remaining + 999999) / 1000000)) > 0) && (input.revents & (POLLIN | POLLHUP | POLLERR)))
+            inputFill();}
+
+    metricsStop(METRIC_SLEEP, start);}
+
+/**
+ * @brief Appends a chunk to the queue; returns -1 if the queue could not grow.
+ */
+static int animationQueueChunk(const char *data, size_t length, unsigned delay) {
+
+    if (animationQueue.count == animationQueue.capacity) {
+        size_t capacity = (animationQueue.capacity == 0) ? 64 : animationQueue.capacity * 2;
+        AnimationChunk *chunks = realloc(animationQueue.chunks, capacity * sizeof *chunks);
+
+        if (chunks == NULL)
+            return -1;
+
+        animationQueue.chunks = chunks;
+        animationQueue.capacity = capacity;}
+
+    if (animationQueue.textLength + length > animationQueue.textCapacity) {
+        size_t capacity = (animationQueue.textCapacity == 0) ? 4096 : animationQueue.textCapacity;
+
+        while (capacity < animationQueue.textLength + length)
+            capacity *= 2;
+
+        char *text = realloc(animationQueue.text, capacity);
+
+        if (text == NULL)
+            return -1;
+
+        animationQueue.text = text;
+        animationQueue.textCapacity = capacity;}
+
+    memcpy(animationQueue.text + animationQueue.textLength, data, length);
+    animationQueue.chunks[animationQueue.count++] = (AnimationChunk) {animationQueue.textLength, length, delay};
+    animationQueue.textLength += length;
+
+    return 0;}
+
+void animationWrite(const char *data, size_t length) {
+
+    if (animationQueueChunk(data, length, 0) != 0) {
+        // Out of memory: give up on scheduling and write straight away.
+        animationDrain();
+        outputWrite(data, length);
+        outputFlush();}}
+
+void animationPrintf(const char *format, ...) {
+
+    char text[ANIMATION_PRINTF_BUFFER];
+    va_list arguments;
+
+    va_start(arguments, format);
+    int length = vsnprintf(text, sizeof text, format, arguments);
+    va_end(arguments);
+
+    if (length > 0)
+        animationWrite(text, ((size_t) length < sizeof text) ? (size_t) length : sizeof text - 1);}
+
+// Multiplier applied by animationDelay ('--speed').
+static double animationSpeed = 1.0;
+
+void animationSetSpeed(double speed) {
+
+    animationSpeed = speed;}
+
+void animationDelay(unsigned microseconds) {
+
+    if (animationSpeed <= 0) // Instant: the output stays the same, only the pauses go
+        return;
+
+    microseconds = (unsigned) ((double) microseconds / animationSpeed + 0.5);
+
+    if (animationQueueChunk(NULL, 0, microseconds) != 0) {
+        animationDrain();
+        animationWait(microseconds);}}
+
+void animationDrain(void) {
+
+    for (size_t i = 0; i < animationQueue.count; i++) {
+
+        const AnimationChunk *chunk = &animationQueue.chunks[i];
+
+        // A pause ends an animation tick: show what the tick produced, then wait.
+        if (chunk->delay > 0) {
+            outputFlush();
+            animationWait(chunk->delay);}
+
+        if (chunk->length > 0)
+            outputWrite(animationQueue.text + chunk->offset, chunk->length);}
+
+    outputFlush();
+    animationQueue.count = 0;
+    animationQueue.textLength = 0;}
+
+char *inputReadLine(char *buffer, int size) {
+
+    animationDrain();   // Everything queued so far (including the prompt) is shown first
+
+    for (;;) {
+
+        size_t available = inputQueue.end - inputQueue.start;
+        size_t limit = (size_t) size - 1;   // Room left for the null terminator
+        const char *newline = memchr(inputQueue.data + inputQueue.start, '\n', (available < limit) ? available : limit);
+        size_t length;
+
+        // Same contract as fgets: stop after a newline, when the buffer is full, or at end of file.
+        if (newline != NULL)
+            length = (size_t) (newline - (inputQueue.data + inputQueue.start)) + 1;
+
+        else if ((available >= limit) || (inputQueue.eof && (available > 0)))
+            length = (available < limit) ? available : limit;
+
+        else if (inputQueue.eof) {
+            buffer[0] = '\0';
+            return NULL;}
+
+        else {
+            inputFill();
+            continue;}
+
+        memcpy(buffer, inputQueue.data + inputQueue.start, length);
+        buffer[length] = '\0';
+        inputQueue.start += length;
+
+        return buffer;}}
+
+const char *inputPeek(size_t *available) {
+
+    animationDrain();
+
+    // Everything typed ahead has been used: the player is thinking.
+    uint64_t start = (inputQueue.start == inputQueue.end) ? metricsStart() : 0;
+
+    while (inputQueue.start == inputQueue.end) {
+
+        if (inputQueue.eof)
+            return NULL;
+
+        inputFill();}
+
+    metricsStop(METRIC_THINK, start);
+
+    *available = inputQueue.end - inputQueue.start;
+
+    return inputQueue.data + inputQueue.start;}
+
+void inputConsume(size_t length) {
+
+    inputQueue.start += length;}
+
+int inputGetChar(void) {
+
+    while (inputQueue.start == inputQueue.end) {
+
+        if (inputQueue.eof)
+            return EOF;
+
+        inputFill();}
+
+    return (unsigned char) inputQueue.data[inputQueue.start++];}
+
+int inputReadInteger(int *value) {
+
+    char line[INPUT_INTEGER_BUFFER];
+    size_t length;
+
+    // Like scanf's %i, blank lines are skipped.
+    do {
+        if (inputReadLine(line, sizeof line) == NULL)
+            return 0;
+
+        length = strlen(line);
+
+        if ((length > 0) && (line[length - 1] != '\n'))
+            clearInputBuffer(); // Discard the rest of an over-long line
+    }
+    while (strspn(line, " \t\r\n\v\f") == length);
+
+    char *end;
+    errno = 0;
+    long number = strtol(line, &end, 0);    // Base 0 accepts decimal, octal and hex, as %i does
+
+    if ((end == line) || (errno == ERANGE) || (number > INT_MAX) || (number < INT_MIN))
+        return 0;
+
+    *value = (int) number;
+
+    return 1;}
+
+void clearInputBuffer(void) {
+    int a;
+    while (((a = inputGetChar()) != '\n') && (a != EOF));}
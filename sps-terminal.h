@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-terminal.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: The game's terminal: the output buffer, the animation scheduler,
+ * buffered player input and the pre-rendered round frames.
+ */
+
+#ifndef SPS_TERMINAL_H
+#define SPS_TERMINAL_H
+
+# include <stddef.h>    // size_t
+# include "sps-art.h" // ART_HEIGHT and the art tables
+
+// Define constants for the terminal
+// Delays to produce retro-like display effect
+#define UI_MICRO_DELAY_SHORT 100000 // Short delay (100 milliseconds).
+#define UI_MICRO_DELAY_MEDIUM 200000    // Medium delay (200 milliseconds).
+#define UI_MICRO_DELAY_LONG 500000  // Long delay (500 milliseconds).
+
+// Data types
+/**
+ * @brief One pre-rendered round frame: the player's art, 'VS' and the computer's art side-by-side.
+ *
+ * All ART_HEIGHT lines are concatenated (each one ending in a newline) so
+ * a line can be printed with a single write of a known length.
+ */
+typedef struct {
+    const char *text;                       // Concatenated lines of the frame
+    size_t lineOffsets[ART_HEIGHT + 1];     // Line i spans text[lineOffsets[i]] to text[lineOffsets[i + 1]]
+} RoundFrame;
+
+// Function prototypes
+/**
+ * @brief Prints a pre-rendered round frame (three ASCII arts side-by-side) to the console.
+ *
+ * This function writes the frame one line at a time, each line being a
+ * single slice of known length. A short delay is introduced after
+ * printing each line to create a retro-like visual effect as the art appears.
+ *
+ * After framesInPlaceEnable, the frame is instead drawn over the previous
+ * one in a fixed region at the top of the screen: only the spans that
+ * differ are written, each after a cursor move, and only changed lines get
+ * the delay.
+ *
+ * @param frame Pointer to the frame built by buildRoundFrames.
+ * @note The lines and delays are queued on the animation scheduler (see animationDelay).
+ */
+void asciiArtPrinter(const RoundFrame *frame);
+
+/**
+ * @brief Switches asciiArtPrinter to in-place drawing if stdout is a terminal that can hold the frames.
+ *
+ * Requires a TTY with a TERM other than "dumb", at least ART_HEIGHT plus a
+ * few rows, and as many columns as the widest frame line. Otherwise the
+ * frames keep scrolling as before.
+ *
+ * @param frames The frames that will be printed.
+ * @return 1 if in-place drawing is on, 0 if the frames keep scrolling.
+ */
+int framesInPlaceEnable(const RoundFrame frames[3][3]);
+
+/**
+ * @brief Gives the whole screen back to scrolling output (queued like any other output) and ends in-place drawing.
+ */
+void framesInPlaceDisable(void);
+
+/**
+ * @brief Pre-renders the nine (player, computer) round frames into one contiguous buffer.
+ *
+ * Frame [p - 1][c - 1] holds the art of choice p, the 'VS' art and the art
+ * of choice c side-by-side, ART_HEIGHT lines each ending in a newline. The
+ * buffer is a region of its own that is made read-only once built, so it
+ * can be shared by every connection and thread and referenced by pending
+ * socket output without being copied.
+ *
+ * @param moveArts Art of each choice, indexed by (choice - 1).
+ * @param vs The 'VS' separator art.
+ * @param frames Frames to fill in.
+ * @return 0 on success, -1 (with errno set) if an art is missing (NULL) or the region could not be mapped or made read-only.
+ */
+int buildRoundFrames(const Art *moveArts[3], const Art *vs, RoundFrame frames[3][3]);
+
+/**
+ * @brief Appends bytes to the game's output buffer.
+ *
+ * All game output reaches stdout through this buffer; it is only written
+ * out by outputFlush (or when it fills up), so the number of write
+ * syscalls does not depend on whether stdout is a terminal or a pipe.
+ *
+ * @param data Bytes to write.
+ * @param length Number of bytes.
+ */
+void outputWrite(const char *data, size_t length);
+
+/**
+ * @brief Writes the output buffer to stdout.
+ *
+ * Called at the end of every animation tick and before the banner is
+ * handed to an external program.
+ */
+void outputFlush(void);
+
+/**
+ * @brief Redirects the output buffer to another file descriptor.
+ *
+ * The buffer is flushed to the current descriptor first. The game always
+ * writes to stdout; the benchmark points the output at /dev/null.
+ *
+ * @param descriptor Descriptor to write to from now on.
+ */
+void outputSetDescriptor(int descriptor);
+
+/**
+ * @brief Queues output to be written by the animation scheduler.
+ *
+ * The bytes are copied, so the caller's buffer may be reused immediately.
+ * Nothing is written until animationDrain() runs, which happens before any
+ * input is read and at exit.
+ *
+ * @param data Bytes to write.
+ * @param length Number of bytes.
+ */
+void animationWrite(const char *data, size_t length);
+
+/**
+ * @brief Formats a string (like printf) and queues it with animationWrite.
+ *
+ * @param format printf-style format string.
+ */
+void animationPrintf(const char *format, ...);
+
+/**
+ * @brief Queues a pause: the next queued output appears after the given time.
+ *
+ * This is the one place every retro-effect delay goes through. The pause is
+ * divided by the speed set with animationSetSpeed (and dropped at speed 0),
+ * and skipped if the player types a complete line ahead on a terminal.
+ *
+ * @param microseconds Length of the pause.
+ */
+void animationDelay(unsigned microseconds);
+
+/**
+ * @brief Sets the speed multiplier applied to every delay queued with animationDelay.
+ *
+ * @param speed 1.0 keeps the original timing, 2.0 halves every delay and 0 disables them.
+ */
+void animationSetSpeed(double speed);
+
+/**
+ * @brief Plays the animation queue: waits out each pause and writes each chunk.
+ *
+ * While waiting, stdin is polled so whatever the player types is kept in a
+ * type-ahead buffer instead of being blocked on. The chunks between two
+ * pauses form one tick and are written to stdout with a single flush.
+ */
+void animationDrain(void);
+
+/**
+ * @brief Reads a line of player input, like fgets on stdin.
+ *
+ * The animation queue is drained first while stdin keeps being read, so a
+ * line typed ahead during the animation is returned immediately.
+ *
+ * @param buffer Destination buffer.
+ * @param size Size of the buffer, including the null terminator.
+ * @return buffer, or NULL at end of input (buffer then holds an empty string).
+ */
+char *inputReadLine(char *buffer, int size);
+
+/**
+ * @brief Returns the player input buffered so far without consuming it, reading more if none is.
+ *
+ * The animation queue is drained first, as by inputReadLine. The bytes stay
+ * buffered until inputConsume is called.
+ *
+ * @param available Set to the number of bytes returned.
+ * @return The buffered bytes, or NULL at end of input.
+ */
+const char *inputPeek(size_t *available);
+
+/**
+ * @brief Consumes bytes returned by inputPeek.
+ *
+ * @param length Number of bytes, at most the number inputPeek returned.
+ */
+void inputConsume(size_t length);
+
+/**
+ * @brief Reads one byte of player input, like getchar.
+ *
+ * @return The byte as an unsigned char, or EOF at end of input.
+ */
+int inputGetChar(void);
+
+/**
+ * @brief Reads an integer on its own line of player input, following scanf's %i rules.
+ *
+ * Blank lines are skipped and the rest of the line after the number is discarded.
+ *
+ * @param value Pointer to store the integer in.
+ * @return 1 if an integer was read, 0 otherwise.
+ */
+int inputReadInteger(int *value);
+
+/**
+ * @brief Clears any remaining characters in the standard input buffer up to a newline or EOF.
+ *
+ * This function is crucial after using inputReadLine (when it doesn't
+ * consume all input), to ensure that leftover characters (like newlines) don't
+ * interfere with subsequent input operations. It reads and discards characters
+ * until a newline character or the end of the input stream (EOF) is encountered.
+ */
+void clearInputBuffer(void);
+
+#endif
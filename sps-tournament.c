@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-tournament.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Round-robin tournaments between computer strategies on a
+ * work-stealing thread pool. Each thread's share of the tasks is a range
+ * packed into one atomic word, so the owner taking a task from the front
+ * and a thief cutting off the back half are both a single compare-and-swap,
+ * with no lock and no queue to allocate.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <stdio.h> // Standard input/output functions (fprintf, perror)
+# include <stdlib.h>    // Standard library functions (calloc, aligned_alloc, free)
+# include <string.h>    // String manipulation functions (memset)
+# include <stdatomic.h> // Atomic operations (atomic_compare_exchange_weak) for the task ranges
+# include <math.h>  // Mathematical functions (log10, pow, fabs, fmax) for the ratings
+# include <time.h>  // Time functions (clock_gettime) for timing the tournament
+# include <pthread.h>   // POSIX threads (pthread_create, pthread_join) for the pool
+# include "sps-tournament.h"    // Tournament types and prototypes
+
+// Define constants for the pool and the ratings
+#define TOURNAMENT_CACHE_LINE 64    // Alignment keeping every thread's range on its own cache line.
+#define TOURNAMENT_ELO_ITERATIONS 10000 // Most iterations of the rating fit.
+#define TOURNAMENT_ELO_TOLERANCE 1e-10  // Relative change of every strength below which the fit has converged.
+
+// Data types
+typedef struct TournamentPool TournamentPool;
+
+/**
+ * @brief One thread of the pool and its share of the tasks.
+ */
+typedef struct {
+    _Alignas(TOURNAMENT_CACHE_LINE) _Atomic uint64_t range; // Tasks left: first in the low 32 bits, end in the high 32 bits
+    TournamentPool *pool;       // Pool the thread belongs to
+    int index;                  // Index of the thread
+    long long steals;           // Tasks this thread stole
+    pthread_t thread;           // Thread running the worker
+    TournamentPairing pairings[TOURNAMENT_MAX_PAIRINGS];    // Counters of the tasks this thread played, by pairing
+} TournamentWorker;
+
+/**
+ * @brief Everything the threads of a tournament share.
+ */
+struct TournamentPool {
+    const TournamentJob *job;   // Tournament being played
+    int tasksPerPairing;        // Tasks every pairing is cut into
+    int (*pairs)[2];            // Strategies of each pairing
+    TournamentWorker *workers;  // Threads of the pool
+};
+
+/**
+ * @brief Packs a range of tasks into one word.
+ */
+static uint64_t tournamentRange(uint32_t first, uint32_t end) {
+
+    return (uint64_t) first | ((uint64_t) end << 32);}
+
+/**
+ * @brief Takes the first task of the thread's own share; returns 0 if it is empty.
+ */
+static int tournamentTake(TournamentWorker *worker, uint32_t *task) {
+
+    uint64_t range = atomic_load(&worker->range);
+
+    while ((uint32_t) range < (uint32_t) (range >> 32))
+        if (atomic_compare_exchange_weak(&worker->range, &range, range + 1)) {
+            *task = (uint32_t) range;
+            return 1;}
+
+    return 0;}
+
+/**
+ * @brief Steals the back half of the first other share that has tasks left; returns 0 if every share is empty.
+ *
+ * The thief runs the first stolen task and keeps the others as its new
+ * share. Its own share is empty while it steals, so no other thread can
+ * change it in the meantime.
+ */
+static int tournamentSteal(TournamentWorker *thief, uint32_t *task) {
+
+    TournamentPool *pool = thief->pool;
+    int threads = pool->job->threads;
+
+    for (int k = 1; k < threads; k++) {
+
+        TournamentWorker *victim = &pool->workers[(thief->index + k) % threads];
+        uint64_t range = atomic_load(&victim->range);
+
+        while ((uint32_t) range < (uint32_t) (range >> 32)) {
+
+            uint32_t first = (uint32_t) range, end = (uint32_t) (range >> 32);
+            uint32_t middle = end - (end - first + 1) / 2;  // At least one task is stolen
+
+            if (atomic_compare_exchange_weak(&victim->range, &range, tournamentRange(first, middle))) {
+                atomic_store(&thief->range, tournamentRange(middle + 1, end));
+                thief->steals += end - middle;
+                *task = middle;
+                return 1;}}}
+
+    return 0;}
+
+/**
+ * @brief Plays one task: a run of series of one pairing, with the sides swapped on odd tasks.
+ */
+static void tournamentPlay(TournamentWorker *worker, uint32_t task) {
+
+    TournamentPool *pool = worker->pool;
+    const TournamentJob *job = pool->job;
+    int pairing = (int) task / pool->tasksPerPairing, chunk = (int) task % pool->tasksPerPairing;
+    long long series = job->series - (long long) chunk * TOURNAMENT_TASK_SERIES;
+    const int *pair = pool->pairs[pairing];
+    int swapped = chunk & 1;    // The second strategy is the player
+    SimulationResult result = {0};
+    Rng rng;
+
+    // SplitMix64 expands each task's seed into an unrelated state.
+    rngInit(&rng, job->rngKind, job->seed ^ ((uint64_t) (task + 1) * 0xd1b54a32d192ed03ULL), 0);
+    simulateStrategySeries((series < TOURNAMENT_TASK_SERIES) ? series : TOURNAMENT_TASK_SERIES, job->bestOf, &job->strategies[pair[swapped]],
+        &job->strategies[pair[!swapped]], resolveRound, &rng, &result);
+
+    // Only sums are kept, so the totals do not depend on which thread played the task.
+    TournamentPairing *played = &worker->pairings[pairing];
+
+    played->firstSeries += swapped ? result.computerSeries : result.playerSeries;
+    played->secondSeries += swapped ? result.playerSeries : result.computerSeries;
+    played->firstRounds += swapped ? result.computerRounds : result.playerRounds;
+    played->secondRounds += swapped ? result.playerRounds : result.computerRounds;
+    played->drawnSeries += result.drawnSeries;
+    played->ties += result.ties;}
+
+/**
+ * @brief Thread entry point: plays the thread's share, then steals until no task is left.
+ */
+static void *tournamentWorkerMain(void *argument) {
+
+    TournamentWorker *worker = argument;
+    uint32_t task;
+
+    while (tournamentTake(worker, &task) || tournamentSteal(worker, &task))
+        tournamentPlay(worker, task);
+
+    return NULL;}
+
+/**
+ * @brief Fits the ratings to the pairings with the Bradley-Terry minorization-maximization iteration.
+ */
+static void tournamentFitElo(const TournamentJob *job, TournamentResult *result) {
+
+    double wins[TOURNAMENT_MAX_STRATEGIES] = {0};
+    double strength[TOURNAMENT_MAX_STRATEGIES];
+    int count = job->count;
+
+    for (int i = 0; i < count; i++)
+        strength[i] = 1.0;
+
+    // One drawn virtual series per pairing keeps every strength above zero.
+    for (int p = 0; p < result->pairingCount; p++) {
+        const TournamentPairing *pairing = &result->pairings[p];
+
+        wins[pairing->first] += (double) pairing->firstSeries + 0.5 * (double) pairing->drawnSeries + 0.5;
+        wins[pairing->second] += (double) pairing->secondSeries + 0.5 * (double) pairing->drawnSeries + 0.5;}
+
+    for (int iteration = 0; iteration < TOURNAMENT_ELO_ITERATIONS; iteration++) {
+
+        double next[TOURNAMENT_MAX_STRATEGIES], denominators[TOURNAMENT_MAX_STRATEGIES] = {0}, logSum = 0.0, change = 0.0;
+
+        for (int p = 0; p < result->pairingCount; p++) {
+            const TournamentPairing *pairing = &result->pairings[p];
+            double games = (double) (pairing->firstSeries + pairing->secondSeries + pairing->drawnSeries + 1);
+            double share = games / (strength[pairing->first] + strength[pairing->second]);
+
+            denominators[pairing->first] += share;
+            denominators[pairing->second] += share;}
+
+        for (int i = 0; i < count; i++) {
+            next[i] = wins[i] / denominators[i];
+            logSum += log10(next[i]);}
+
+        // Strengths are only defined up to a factor: keep their geometric mean at 1.
+        for (int i = 0; i < count; i++) {
+            double scaled = next[i] / pow(10.0, logSum / count);
+
+            change = fmax(change, fabs(scaled - strength[i]) / strength[i]);
+            strength[i] = scaled;}
+
+        if (change < TOURNAMENT_ELO_TOLERANCE)
+            break;}
+
+    for (int i = 0; i < count; i++)
+        result->elo[i] = TOURNAMENT_ELO_BASE + 400.0 * log10(strength[i]);}
+
+double runTournament(const TournamentJob *job, TournamentResult *result) {
+
+    struct timespec start, end;
+    TournamentPool pool = {.job = job, .tasksPerPairing = (int) ((job->series + TOURNAMENT_TASK_SERIES - 1) / TOURNAMENT_TASK_SERIES)};
+    int threads = job->threads;
+
+    result->pairingCount = job->count * (job->count - 1) / 2;
+    result->tasks = (long long) result->pairingCount * ((job->series + TOURNAMENT_TASK_SERIES - 1) / TOURNAMENT_TASK_SERIES);
+    result->steals = 0;
+
+    // Task numbers must fit the halves of a range word.
+    if (result->tasks > UINT32_MAX) {
+        fprintf(stderr, "A tournament can have at most %u tasks of %i series...\n", UINT32_MAX, TOURNAMENT_TASK_SERIES);
+        return -1.0;}
+
+    pool.pairs = calloc((size_t) result->pairingCount, sizeof *pool.pairs);
+    pool.workers = aligned_alloc(TOURNAMENT_CACHE_LINE, (size_t) threads * sizeof *pool.workers);
+
+    if ((pool.pairs == NULL) || (pool.workers == NULL)) {
+        perror("Tournament allocation failed");
+        free(pool.pairs);
+        free(pool.workers);
+        return -1.0;}
+
+    for (int i = 0, p = 0; i < job->count; i++)
+        for (int j = i + 1; j < job->count; j++, p++) {
+            pool.pairs[p][0] = i;
+            pool.pairs[p][1] = j;}
+
+    // Contiguous, even shares in task order; stealing evens out what the pairings' costs do not.
+    for (int i = 0; i < threads; i++) {
+        uint32_t first = (uint32_t) (result->tasks * i / threads), last = (uint32_t) (result->tasks * (i + 1) / threads);
+
+        memset(pool.workers[i].pairings, 0, sizeof pool.workers[i].pairings);
+        atomic_init(&pool.workers[i].range, tournamentRange(first, last));
+        pool.workers[i].pool = &pool;
+        pool.workers[i].index = i;
+        pool.workers[i].steals = 0;}
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    // Worker 0 runs on the calling thread, the others get a thread each.
+    int started = 1;
+
+    for (; started < threads; started++)
+        if (pthread_create(&pool.workers[started].thread, NULL, tournamentWorkerMain, &pool.workers[started]) != 0)
+            break;
+
+    if (started == threads)
+        tournamentWorkerMain(&pool.workers[0]);
+
+    for (int i = 1; i < started; i++)
+        pthread_join(pool.workers[i].thread, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (started != threads) {
+        fprintf(stderr, "Could not start tournament thread %i...\n", started);
+        free(pool.pairs);
+        free(pool.workers);
+        return -1.0;}
+
+    // Single reduction once every thread has finished.
+    for (int p = 0; p < result->pairingCount; p++) {
+
+        TournamentPairing *pairing = &result->pairings[p];
+
+        *pairing = (TournamentPairing) {.first = pool.pairs[p][0], .second = pool.pairs[p][1]};
+
+        for (int i = 0; i < threads; i++) {
+            const TournamentPairing *played = &pool.workers[i].pairings[p];
+
+            pairing->firstSeries += played->firstSeries;
+            pairing->secondSeries += played->secondSeries;
+            pairing->drawnSeries += played->drawnSeries;
+            pairing->firstRounds += played->firstRounds;
+            pairing->secondRounds += played->secondRounds;
+            pairing->ties += played->ties;}}
+
+    for (int i = 0; i < threads; i++)
+        result->steals += pool.workers[i].steals;
+
+    free(pool.pairs);
+    free(pool.workers);
+
+    tournamentFitElo(job, result);
+
+    return (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;}
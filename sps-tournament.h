@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-tournament.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: Round-robin tournaments between computer strategies
+ * ('--tournament'): every pairing is cut into tasks of a few hundred series,
+ * the tasks are played on a work-stealing thread pool, and the results are
+ * rated with Elo ratings fitted to every series played.
+ */
+
+#ifndef SPS_TOURNAMENT_H
+#define SPS_TOURNAMENT_H
+
+# include <stdint.h>    // Fixed-width integer types (uint64_t) for the seed
+# include "sps-engine.h"    // Strategies, random number generators
+
+// Define constants for tournaments
+#define TOURNAMENT_MAX_STRATEGIES 16    // Strategies accepted by '--tournament'.
+#define TOURNAMENT_MAX_PAIRINGS (TOURNAMENT_MAX_STRATEGIES * (TOURNAMENT_MAX_STRATEGIES - 1) / 2)   // Pairings of a full round robin.
+#define TOURNAMENT_DEFAULT_SERIES 10000 // Series per pairing when '--simulate' does not say.
+#define TOURNAMENT_TASK_SERIES 250  // Series per task: the unit of work a thread takes or steals.
+#define TOURNAMENT_ELO_BASE 1500.0  // Average rating of the strategies of a tournament.
+
+// Data types
+/**
+ * @brief Results of one pairing, from the point of view of its first strategy.
+ */
+typedef struct {
+    int first;                  // Index of the first strategy
+    int second;                 // Index of the second strategy
+    long long firstSeries;      // Series won by the first strategy
+    long long secondSeries;     // Series won by the second strategy
+    long long drawnSeries;      // Series stopped at STRATEGY_MAX_SERIES_ROUNDS rounds
+    long long firstRounds;      // Rounds won by the first strategy
+    long long secondRounds;     // Rounds won by the second strategy
+    long long ties;             // Tied rounds
+} TournamentPairing;
+
+/**
+ * @brief A round robin, as played by runTournament.
+ */
+typedef struct {
+    const StrategySpec *strategies; // Strategies taking part
+    int count;                  // Number of strategies (2 to TOURNAMENT_MAX_STRATEGIES)
+    long long series;           // Series per pairing
+    int bestOf;                 // 'Best-of' length of every series
+    uint64_t seed;              // Seed of every task's random stream
+    RngKind rngKind;            // Random number generator algorithm
+    int threads;                // Threads of the pool
+} TournamentJob;
+
+/**
+ * @brief Results of a round robin.
+ */
+typedef struct {
+    TournamentPairing pairings[TOURNAMENT_MAX_PAIRINGS];    // Every pairing, in the order (0, 1), (0, 2) ... (1, 2) ...
+    int pairingCount;           // Number of pairings
+    double elo[TOURNAMENT_MAX_STRATEGIES];  // Rating of each strategy
+    long long tasks;            // Tasks played
+    long long steals;           // Tasks taken from another thread's share
+} TournamentResult;
+
+// Function prototypes
+/**
+ * @brief Plays every pairing of a round robin and rates the strategies.
+ *
+ * Every pairing's series are cut into tasks of up to TOURNAMENT_TASK_SERIES
+ * series; the strategies keep learning within a task and start afresh in
+ * the next one, where they also swap sides. Task t draws from its own
+ * stream of the seed, so the results only depend on the seed, never on
+ * the thread count or on which thread played which task.
+ *
+ * The tasks are split evenly between the threads in order. A thread takes
+ * its next task from the front of its share; once the share is empty, it
+ * steals the back half of another thread's, so pairings of slow strategies
+ * do not leave the other threads idle.
+ *
+ * Ratings are the Bradley-Terry (Elo) fit of every series, a drawn series
+ * counting half, with one drawn virtual series per pairing so that a
+ * strategy that never won still has a finite rating; they are shifted to
+ * average TOURNAMENT_ELO_BASE.
+ *
+ * @param job Pointer to the tournament to play.
+ * @param result Pointer to the results to fill in.
+ * @return The elapsed seconds, or a negative value if the pool could not be started.
+ */
+double runTournament(const TournamentJob *job, TournamentResult *result);
+
+#endif
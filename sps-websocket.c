@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-websocket.c
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: WebSocket handshake (SHA-1 and base64 of the accept key),
+ * client frame decoder and round message encoder.
+ */
+
+# define _DEFAULT_SOURCE    // Define _DEFAULT_SOURCE to expose POSIX and other common extensions.
+# include <string.h>    // String manipulation functions (memcpy, memmove)
+# include "sps-terminal.h"  // UI_MICRO_DELAY_* timing hints of a round
+# include "sps-websocket.h" // WebSocket constants and prototypes
+
+// Define constants for the handshake
+#define WEBSOCKET_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"   // Appended to the client's key before hashing.
+#define WEBSOCKET_GUID_LENGTH 36    // Length of WEBSOCKET_GUID.
+#define SHA1_DIGEST_LENGTH 20   // Bytes of a SHA-1 digest.
+
+// Parts of a client frame, in the order the decoder expects them
+enum {
+    READER_HEADER = 0,  // FIN bit and opcode
+    READER_LENGTH,      // Mask bit and 7-bit length
+    READER_LENGTH_HIGH, // High byte of a 16-bit length
+    READER_LENGTH_LOW,  // Low byte of a 16-bit length
+    READER_MASK,        // First of the four masking key bytes
+    READER_PAYLOAD = READER_MASK + 4
+};
+
+/**
+ * @brief Rotates a 32-bit word left.
+ */
+static uint32_t rotateLeft(uint32_t value, int count) {
+
+    return (value << count) | (value >> (32 - count));}
+
+/**
+ * @brief Hashes a message of at most 119 bytes (two blocks) with SHA-1.
+ */
+static void sha1(const uint8_t *message, size_t length, uint8_t digest[SHA1_DIGEST_LENGTH]) {
+
+    uint32_t state[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    uint8_t blocks[128] = {0};
+    size_t size = (length + 9 <= 64) ? 64 : 128;
+
+    // The message, a 1 bit, zeros, then its length in bits as a big-endian 64-bit number.
+    memcpy(blocks, message, length);
+    blocks[length] = 0x80;
+
+    for (int i = 0; i < 8; i++)
+        blocks[size - 1 - i] = (uint8_t) ((uint64_t) length * 8 >> (8 * i));
+
+    for (size_t block = 0; block < size; block += 64) {
+
+        uint32_t w[80];
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        for (int i = 0; i < 16; i++)
+            w[i] = (uint32_t) blocks[block + 4 * i] << 24 | (uint32_t) blocks[block + 4 * i + 1] << 16 | (uint32_t) blocks[block + 4 * i + 2] << 8 | blocks[block + 4 * i + 3];
+
+        for (int i = 16; i < 80; i++)
+            w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+        for (int i = 0; i < 80; i++) {
+
+            uint32_t f = (i < 20) ? ((b & c) | (~b & d)) + 0x5a827999
+                : (i < 40) ? (b ^ c ^ d) + 0x6ed9eba1
+                : (i < 60) ? ((b & c) | (b & d) | (c & d)) + 0x8f1bbcdc
+                : (b ^ c ^ d) + 0xca62c1d6;
+            uint32_t next = rotateLeft(a, 5) + f + e + w[i];
+
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = next;}
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;}
+
+    for (int i = 0; i < SHA1_DIGEST_LENGTH; i++)
+        digest[i] = (uint8_t) (state[i / 4] >> (24 - 8 * (i % 4)));}
+
+void webSocketAccept(const char key[WEBSOCKET_KEY_LENGTH], char accept[WEBSOCKET_ACCEPT_LENGTH]) {
+
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint8_t message[WEBSOCKET_KEY_LENGTH + WEBSOCKET_GUID_LENGTH];
+    uint8_t digest[SHA1_DIGEST_LENGTH + 1] = {0};   // One spare zero byte for the last base64 group
+
+    memcpy(message, key, WEBSOCKET_KEY_LENGTH);
+    memcpy(message + WEBSOCKET_KEY_LENGTH, WEBSOCKET_GUID, WEBSOCKET_GUID_LENGTH);
+    sha1(message, sizeof message, digest);
+
+    // Seven groups of three bytes give 28 characters, the last one padding.
+    for (int group = 0; group < 7; group++) {
+
+        uint32_t bits = (uint32_t) digest[3 * group] << 16 | (uint32_t) digest[3 * group + 1] << 8 | digest[3 * group + 2];
+
+        for (int i = 0; i < 4; i++)
+            accept[4 * group + i] = alphabet[(bits >> (18 - 6 * i)) & 63];}
+
+    accept[WEBSOCKET_ACCEPT_LENGTH - 1] = '=';}
+
+size_t webSocketDecode(WebSocketReader *reader, const uint8_t *data, size_t length, char *output, int *events) {
+
+    size_t written = 0;
+
+    *events = 0;
+
+    for (size_t i = 0; i < length; i++) {
+
+        uint8_t byte = data[i];
+
+        switch (reader->state) {
+
+            case READER_HEADER:
+                reader->opcode = byte & 0x8f;
+                reader->state = READER_LENGTH;
+                continue;
+
+            case READER_LENGTH:
+                // Clients must mask their frames, and nothing this game receives needs a 64-bit length.
+                if (!(byte & 0x80) || ((byte & 0x7f) == 127)) {
+                    *events |= WEBSOCKET_EVENT_ERROR;
+                    return written;}
+
+                reader->remaining = byte & 0x7f;
+                reader->state = ((byte & 0x7f) == 126) ? READER_LENGTH_HIGH : READER_MASK;
+                continue;
+
+            case READER_LENGTH_HIGH:
+                reader->remaining = (uint16_t) (byte << 8);
+                reader->state = READER_LENGTH_LOW;
+                continue;
+
+            case READER_LENGTH_LOW:
+                reader->remaining |= byte;
+                reader->state = READER_MASK;
+                continue;
+
+            case READER_PAYLOAD: {
+                uint8_t key = reader->mask[0];
+
+                // Data frames (continuation, text, binary) are input; control frames' payloads are skipped.
+                if ((reader->opcode & 0x0f) < 8)
+                    output[written++] = (char) (byte ^ key);
+
+                memmove(reader->mask, reader->mask + 1, 3);
+                reader->mask[3] = key;
+                reader->remaining--;
+                break;}
+
+            default:
+                reader->mask[reader->state++ - READER_MASK] = byte;
+                break;}
+
+        if ((reader->state != READER_PAYLOAD) || (reader->remaining > 0))
+            continue;
+
+        // The frame is complete.
+        int opcode = reader->opcode & 0x0f;
+
+        if (opcode == 8)
+            *events |= WEBSOCKET_EVENT_CLOSE;
+
+        else if (opcode == 9)
+            *events |= WEBSOCKET_EVENT_PING;
+
+        else if ((opcode < 8) && (reader->opcode & 0x80))
+            output[written++] = '\n';
+
+        reader->state = READER_HEADER;}
+
+    return written;}
+
+size_t webSocketHeader(uint8_t header[WEBSOCKET_TEXT_HEADER], int opcode, size_t length) {
+
+    header[0] = (uint8_t) (0x80 | opcode);
+
+    if (length <= 125) {
+        header[1] = (uint8_t) length;
+        return 2;}
+
+    header[1] = 126;
+    header[2] = (uint8_t) (length >> 8);
+    header[3] = (uint8_t) length;
+
+    return 4;}
+
+/**
+ * @brief Stores the low bytes of a number big-endian.
+ */
+static void storeBigEndian(uint8_t *destination, uint32_t value, int bytes) {
+
+    for (int i = 0; i < bytes; i++)
+        destination[i] = (uint8_t) (value >> (8 * (bytes - 1 - i)));}
+
+void webSocketRoundMessage(uint8_t message[WEBSOCKET_ROUND_LENGTH], int playerChoice, int computerChoice, int outcome, int playerWins, int computerWins, int winsNeeded) {
+
+    uint8_t *payload = message + webSocketHeader(message, 2, WEBSOCKET_ROUND_LENGTH - 2);
+
+    payload[0] = WEBSOCKET_ROUND_MESSAGE;
+    payload[1] = (uint8_t) playerChoice;
+    payload[2] = (uint8_t) computerChoice;
+    payload[3] = (uint8_t) outcome;
+    storeBigEndian(payload + 4, (uint32_t) playerWins, 4);
+    storeBigEndian(payload + 8, (uint32_t) computerWins, 4);
+    storeBigEndian(payload + 12, (uint32_t) winsNeeded, 4);
+    storeBigEndian(payload + 16, UI_MICRO_DELAY_SHORT / 1000, 2);
+    storeBigEndian(payload + 18, UI_MICRO_DELAY_LONG / 1000, 2);}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2025 Rithwik A. Agarwal
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * This file is part of the "Stone-Paper-Scissors Game" project.
+ * See the LICENSE file for the full license text.
+ */
+
+/**
+ * File: sps-websocket.h
+ * Author: Rithwik A. Agarwal
+ * Date: October 14, 2026
+ * Description: WebSocket (RFC 6455) pieces of the server's browser
+ * gateway: the handshake's accept key, a streaming decoder of client
+ * frames and the binary message a round is sent as.
+ */
+
+#ifndef SPS_WEBSOCKET_H
+#define SPS_WEBSOCKET_H
+
+# include <stddef.h>    // size_t
+# include <stdint.h>    // Fixed-width integer types (uint8_t, uint16_t)
+
+// Define constants for the WebSocket protocol
+#define WEBSOCKET_KEY_LENGTH 24     // Characters of a Sec-WebSocket-Key (16 bytes in base64).
+#define WEBSOCKET_ACCEPT_LENGTH 28  // Characters of a Sec-WebSocket-Accept (a SHA-1 digest in base64).
+#define WEBSOCKET_MESSAGE_MAX 65535 // Longest message sent or received (a 16-bit length).
+#define WEBSOCKET_TEXT_HEADER 4     // Header of a text message of up to WEBSOCKET_MESSAGE_MAX bytes.
+#define WEBSOCKET_CLOSE_FRAME "\x88\x00"    // Close frame without a status, sent when a game ends.
+#define WEBSOCKET_PONG_FRAME "\x8a\x00"     // Empty pong, the answer to any ping.
+#define WEBSOCKET_CONTROL_FRAME_LENGTH 2    // Length of WEBSOCKET_CLOSE_FRAME and WEBSOCKET_PONG_FRAME.
+#define WEBSOCKET_ROUND_MESSAGE 1   // Type byte of a round message.
+#define WEBSOCKET_ROUND_LENGTH 22   // Bytes of a round message, header included.
+
+// Events reported by webSocketDecode
+#define WEBSOCKET_EVENT_CLOSE 1     // The client sent a close frame.
+#define WEBSOCKET_EVENT_PING 2      // The client sent a ping.
+#define WEBSOCKET_EVENT_ERROR 4     // A frame was unmasked or too long: the connection must be dropped.
+
+// Data types
+/**
+ * @brief Where the decoder of a connection is in the client's frames.
+ */
+typedef struct {
+    uint8_t mask[4];        // Masking key, rotated by one byte per payload byte
+    uint16_t remaining;     // Payload bytes of the frame still to come
+    uint8_t state;          // Part of the frame expected next
+    uint8_t opcode;         // Opcode of the frame, with the FIN bit (0x80)
+} WebSocketReader;
+
+// Function prototypes
+/**
+ * @brief Computes the Sec-WebSocket-Accept answer to a client's key.
+ *
+ * @param key The client's Sec-WebSocket-Key.
+ * @param accept Receives the answer (not null-terminated).
+ */
+void webSocketAccept(const char key[WEBSOCKET_KEY_LENGTH], char accept[WEBSOCKET_ACCEPT_LENGTH]);
+
+/**
+ * @brief Decodes received bytes into the unmasked payload of the client's text and binary frames.
+ *
+ * Frames may be split anywhere across calls. Every complete message is
+ * followed by a newline, so each message the browser sends reads as one
+ * input line; control frames are left out of the output and reported.
+ *
+ * @param reader Decoder of the connection (zeroed before the first call).
+ * @param data Received bytes.
+ * @param length Number of received bytes.
+ * @param output Buffer of at least length + 1 bytes.
+ * @param events Set to the WEBSOCKET_EVENT_* flags of the frames seen.
+ * @return Number of bytes written to output.
+ */
+size_t webSocketDecode(WebSocketReader *reader, const uint8_t *data, size_t length, char *output, int *events);
+
+/**
+ * @brief Writes the header of a final server frame with the smallest length field; returns its size (2 or 4).
+ *
+ * @param header Buffer of WEBSOCKET_TEXT_HEADER bytes.
+ * @param opcode Opcode of the frame (1 for text, 2 for binary).
+ * @param length Payload bytes (at most WEBSOCKET_MESSAGE_MAX).
+ */
+size_t webSocketHeader(uint8_t header[WEBSOCKET_TEXT_HEADER], int opcode, size_t length);
+
+/**
+ * @brief Formats a round as one binary message: everything the browser needs to draw it.
+ *
+ * The payload holds, after the WEBSOCKET_ROUND_MESSAGE type byte, the
+ * player's and the computer's choices (1 Stone, 2 Paper, 3 Scissors), the
+ * outcome (a ROUND_* value), then big-endian fields: both scores and the
+ * wins needed (32 bits each), and the timing hints of the interactive game
+ * in milliseconds (16 bits each: the pause after each art line and after
+ * each closing dot).
+ *
+ * @param message Buffer of WEBSOCKET_ROUND_LENGTH bytes.
+ */
+void webSocketRoundMessage(uint8_t message[WEBSOCKET_ROUND_LENGTH], int playerChoice, int computerChoice, int outcome, int playerWins, int computerWins, int winsNeeded);
+
+#endif